@@ -224,6 +224,51 @@ void compute_call_sites() {
   }
 }
 
+//
+// Rebuild fn->calledBy without touching any other function.  The
+// per-symbol SymExpr lists are kept up to date as the tree is edited,
+// so this costs time proportional to the uses of fn (and, for virtual
+// methods, of the methods it overrides) rather than a walk over every
+// function in the program.  Passes that only need the callers of a
+// few functions should use this instead of compute_call_sites().
+//
+void update_fn_call_sites(FnSymbol* fn) {
+  typedef MapElem<FnSymbol*, Vec<FnSymbol*>*> ChildMapElem;
+
+  if (fn->calledBy)
+    fn->calledBy->clear();
+  else
+    fn->calledBy = new Vec<CallExpr*>();
+
+  for_SymbolSymExprs(se, fn) {
+    if (CallExpr* call = toCallExpr(se->parentExpr)) {
+      if (fn == call->resolvedFunction()) {
+        fn->calledBy->add(call);
+
+      } else if (call->isPrimitive(PRIM_VIRTUAL_METHOD_CALL) &&
+                 toSymExpr(call->get(1))->symbol() == fn) {
+        fn->calledBy->add(call);
+      }
+    }
+  }
+
+  if (fn->hasFlag(FLAG_VIRTUAL)) {
+    // A virtual call through any method that fn overrides may reach fn.
+    form_Map(ChildMapElem, el, virtualChildrenMap) {
+      if (el->key != fn && el->value && el->value->in(fn)) {
+        for_SymbolSymExprs(se, el->key) {
+          if (CallExpr* call = toCallExpr(se->parentExpr)) {
+            if (call->isPrimitive(PRIM_VIRTUAL_METHOD_CALL) &&
+                toSymExpr(call->get(1))->symbol() == el->key) {
+              fn->calledBy->add(call);
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
 // builds the def and use maps for every variable/argument
 // in the entire program.
 void buildDefUseMaps(Map<Symbol*,Vec<SymExpr*>*>& defMap,
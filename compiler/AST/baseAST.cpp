@@ -44,6 +44,8 @@
 #include "type.h"
 #include "WhileStmt.h"
 
+#include <cstdlib>
+#include <new>
 #include <ostream>
 #include <sstream>
 #include <string>
@@ -335,6 +337,74 @@ const std::string BaseAST::tabText = "   ";
 BaseAST::~BaseAST() {
 }
 
+/************************************* | **************************************
+*                                                                             *
+* Allocation of AST nodes.                                                    *
+*                                                                             *
+* Millions of nodes are created and most of them die within a pass or two.   *
+* Rather than going through malloc/free for each one, nodes are bump-         *
+* allocated from large chunks, so that nodes created together sit together   *
+* in memory, and the nodes that cleanAst() deletes go on a free list for     *
+* their size to be reused by the next pass.  Chunks are never returned to    *
+* the system; the compiler exits shortly after destroyAst().                 *
+*                                                                             *
+************************************** | *************************************/
+
+static const size_t kAstPoolGrain     = 16;
+static const size_t kAstPoolMaxSize   = 1024;
+static const size_t kAstPoolChunkSize = 1024 * 1024;
+
+struct AstPoolFreeNode {
+  AstPoolFreeNode* next;
+};
+
+static AstPoolFreeNode* sAstPoolFree[kAstPoolMaxSize / kAstPoolGrain + 1];
+
+static char*            sAstPoolNext  = NULL;
+static char*            sAstPoolLimit = NULL;
+
+void* BaseAST::operator new(size_t size) {
+  size_t bucket = (size + kAstPoolGrain - 1) / kAstPoolGrain;
+  size_t bytes  = bucket * kAstPoolGrain;
+  void*  retval = NULL;
+
+  if (size > kAstPoolMaxSize) {
+    retval = ::operator new(size);
+
+  } else if (sAstPoolFree[bucket] != NULL) {
+    retval               = sAstPoolFree[bucket];
+    sAstPoolFree[bucket] = sAstPoolFree[bucket]->next;
+
+  } else {
+    if ((size_t) (sAstPoolLimit - sAstPoolNext) < bytes) {
+      sAstPoolNext = (char*) malloc(kAstPoolChunkSize);
+
+      if (sAstPoolNext == NULL)
+        throw std::bad_alloc();
+
+      sAstPoolLimit = sAstPoolNext + kAstPoolChunkSize;
+    }
+
+    retval       = sAstPoolNext;
+    sAstPoolNext = sAstPoolNext + bytes;
+  }
+
+  return retval;
+}
+
+void BaseAST::operator delete(void* ptr, size_t size) {
+  if (size > kAstPoolMaxSize) {
+    ::operator delete(ptr);
+
+  } else if (ptr != NULL) {
+    size_t           bucket = (size + kAstPoolGrain - 1) / kAstPoolGrain;
+    AstPoolFreeNode* node   = (AstPoolFreeNode*) ptr;
+
+    node->next           = sAstPoolFree[bucket];
+    sAstPoolFree[bucket] = node;
+  }
+}
+
 int BaseAST::linenum() const {
   return astloc.lineno;
 }
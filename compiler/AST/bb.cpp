@@ -33,10 +33,10 @@
 #include <queue>
 
 
-int                                          BasicBlock::nextID     = 0;
-BasicBlock*                                  BasicBlock::basicBlock = NULL;
-Map<LabelSymbol*, std::vector<BasicBlock*>*> BasicBlock::gotoMaps;
-Map<LabelSymbol*, BasicBlock*>               BasicBlock::labelMaps;
+__thread int                                           BasicBlock::nextID     = 0;
+__thread BasicBlock*                                   BasicBlock::basicBlock = NULL;
+__thread Map<LabelSymbol*, std::vector<BasicBlock*>*>* BasicBlock::gotoMaps   = NULL;
+__thread Map<LabelSymbol*, BasicBlock*>*               BasicBlock::labelMaps  = NULL;
 
 BasicBlock::BasicBlock() {
   id = nextID++;
@@ -46,8 +46,8 @@ BasicBlock::BasicBlock() {
 void BasicBlock::reset(FnSymbol* fn) {
   clear(fn);
 
-  gotoMaps.clear();
-  labelMaps.clear();
+  gotoMaps  = new Map<LabelSymbol*, std::vector<BasicBlock*>*>();
+  labelMaps = new Map<LabelSymbol*, BasicBlock*>();
 
   fn->basicBlocks = new std::vector<BasicBlock*>();
 
@@ -75,6 +75,12 @@ void BasicBlock::buildBasicBlocks(FnSymbol* fn) {
 
   fn->basicBlocks->push_back(BasicBlock::steal());
 
+  delete gotoMaps;
+  delete labelMaps;
+
+  gotoMaps  = NULL;
+  labelMaps = NULL;
+
   removeEmptyBlocks(fn);
 
   if (fVerify)
@@ -204,13 +210,13 @@ void BasicBlock::buildBasicBlocks(FnSymbol* fn, Expr* stmt, bool mark) {
   } else if (GotoStmt* s = toGotoStmt(stmt)) {
     LabelSymbol* label = toLabelSymbol(toSymExpr(s->label)->symbol());
 
-    if (BasicBlock* bb = labelMaps.get(label)) {
+    if (BasicBlock* bb = labelMaps->get(label)) {
       // Thread this block to its destination label.
       thread(basicBlock, bb);
 
     } else {
       // Set up goto map, so this block's successor can be back-patched later.
-      std::vector<BasicBlock*>* vbb = gotoMaps.get(label);
+      std::vector<BasicBlock*>* vbb = gotoMaps->get(label);
 
       if (vbb == NULL) {
         vbb = new std::vector<BasicBlock*>();
@@ -218,7 +224,7 @@ void BasicBlock::buildBasicBlocks(FnSymbol* fn, Expr* stmt, bool mark) {
 
       vbb->push_back(basicBlock);
 
-      gotoMaps.put(label, vbb);
+      gotoMaps->put(label, vbb);
     }
 
     append(s, mark); // Put the goto at the end of its block.
@@ -274,13 +280,13 @@ void BasicBlock::buildBasicBlocks(FnSymbol* fn, Expr* stmt, bool mark) {
 
       // See if we have any unresolved references to this label,
       // and resolve them.
-      if (std::vector<BasicBlock*>* vbb = gotoMaps.get(label)) {
+      if (std::vector<BasicBlock*>* vbb = gotoMaps->get(label)) {
         for_vector(BasicBlock, bb, *vbb) {
           thread(bb, basicBlock);
         }
       }
 
-      labelMaps.put(label, basicBlock);
+      labelMaps->put(label, basicBlock);
     } else {
       append(stmt, mark);
 
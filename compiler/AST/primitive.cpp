@@ -609,6 +609,12 @@ initPrimitive() {
   prim_def(PRIM_OR_ASSIGN, "|=", returnInfoVoid, true);
   prim_def(PRIM_XOR_ASSIGN, "^=", returnInfoVoid, true);
   prim_def(PRIM_REDUCE_ASSIGN, "reduce=", returnInfoVoid, true);
+  // forall-body assignment that may be routed through an aggregator,
+  // see autoAggregation.cpp
+  prim_def(PRIM_MAYBE_AGGREGATE_ASSIGN, "maybe aggregate assign", returnInfoVoid, true);
+  prim_def(PRIM_MAYBE_AGGREGATE_ATOMIC, "maybe aggregate atomic", returnInfoVoid, true);
+  // whether a run of statements may be fused, see forallFusion.cpp
+  prim_def(PRIM_FUSIBLE, "fusible", returnInfoBool);
 
   prim_def(PRIM_MIN, "_min", returnInfoFirst);
   prim_def(PRIM_MAX, "_max", returnInfoFirst);
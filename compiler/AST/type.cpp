@@ -790,6 +790,10 @@ void initCompilerGlobals() {
   gWarnUnstable->addFlag(FLAG_PARAM);
   setupBoolGlobal(gWarnUnstable, fWarnUnstable);
 
+  gVectorize = new VarSymbol("chpl_vectorize", dtBool);
+  gVectorize->addFlag(FLAG_PARAM);
+  setupBoolGlobal(gVectorize, !fNoVectorize);
+
   // defined and maintained by the runtime
   gNodeID = new VarSymbol("chpl_nodeID", dtInt[INT_SIZE_32]);
   gNodeID->addFlag(FLAG_EXTERN);
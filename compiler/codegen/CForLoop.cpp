@@ -90,6 +90,8 @@ GenRet CForLoop::codegen()
 
   codegenStmt(this);
 
+  reportVectorization();
+
   if (outfile)
   {
     BlockStmt*  initBlock = initBlockGet();
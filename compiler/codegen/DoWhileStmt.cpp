@@ -42,6 +42,8 @@ GenRet DoWhileStmt::codegen()
 
   codegenStmt(this);
 
+  reportVectorization();
+
   if (outfile)
   {
     codegenOrderIndependence();
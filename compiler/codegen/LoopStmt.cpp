@@ -19,8 +19,17 @@
 
 #include "LoopStmt.h"
 
+#include "astutil.h"
 #include "codegen.h"
 #include "driver.h"
+#include "expr.h"
+#include "stringutil.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+static const char* vectorizationBlocker(LoopStmt* loop);
 
 // If vectorization is enabled and this loop is order independent, codegen
 // CHPL_PRAGMA_IVDEP. This method is a no-op if vectorization is off, or the
@@ -48,3 +57,148 @@ void LoopStmt::codegenOrderIndependence()
     info->cStatements.push_back(ivdepStr+'\n');
   }
 }
+
+// With --report-vectorization, say whether this loop is vectorizable and, if
+// not, what stands in the way.  A loop is vectorizable when it gets the
+// hints above and its body is straight-line code; the back-end compiler
+// still makes the final decision.
+//
+// One source loop can become several loops, e.g. the coforall of an
+// inlined leader iterator, the loop nest of a multidimensional follower,
+// and the fast and regular followers, and they all carry the source line.
+// So the verdicts are merged per source line and printed once codegen is
+// done: the verdict for the innermost loop wins over those of the loops
+// that only enclose it or create the tasks that run it.
+struct VectorizationVerdict
+{
+  std::string where;
+  const char* blocker;
+};
+
+static std::vector<VectorizationVerdict> verdicts;
+static std::map<std::string, size_t>     verdictIndex;
+
+static const char* blockerOn    = "it contains an on statement";
+static const char* blockerTasks = "it creates tasks";
+static const char* blockerLoop  = "it contains another loop";
+
+// Lower ranks describe the source loop better.
+static int verdictRank(const char* blocker)
+{
+  if (blocker == NULL)
+    return 0;
+
+  if (blocker == blockerOn    ||
+      blocker == blockerTasks ||
+      blocker == blockerLoop)
+    return 2;
+
+  return 1;
+}
+
+void LoopStmt::reportVectorization()
+{
+  if (fReportVectorization)
+  {
+    ModuleSymbol* mod = toModuleSymbol(this->getModule());
+    INT_ASSERT(mod);
+
+    if (developer || mod->modTag == MOD_USER)
+    {
+      const char* blocker = vectorizationBlocker(this);
+      std::string where   = std::string(this->fname()) + ":" +
+                            istr(this->linenum());
+
+      std::map<std::string, size_t>::iterator it = verdictIndex.find(where);
+
+      if (it == verdictIndex.end())
+      {
+        VectorizationVerdict verdict = { where, blocker };
+
+        verdictIndex[where] = verdicts.size();
+        verdicts.push_back(verdict);
+      }
+      else if (verdictRank(blocker) <
+               verdictRank(verdicts[it->second].blocker))
+      {
+        verdicts[it->second].blocker = blocker;
+      }
+    }
+  }
+}
+
+void LoopStmt::printVectorizationReport()
+{
+  for (size_t i = 0; i < verdicts.size(); i++)
+  {
+    if (verdicts[i].blocker == NULL)
+      printf("Loop is vectorizable (%s)\n", verdicts[i].where.c_str());
+    else
+      printf("Loop is not vectorizable: %s (%s)\n",
+             verdicts[i].blocker, verdicts[i].where.c_str());
+  }
+
+  verdicts.clear();
+  verdictIndex.clear();
+}
+
+// The first thing found that keeps 'loop' from being vectorized, or NULL.
+static const char* vectorizationBlocker(LoopStmt* loop)
+{
+  std::vector<CallExpr*> calls;
+
+  collectCallExprs(loop, calls);
+
+  // By now, tasks are started by calling the wrappers of task functions.
+  for_vector(CallExpr, call, calls)
+  {
+    if (FnSymbol* fn = call->resolvedFunction())
+    {
+      if (fn->hasFlag(FLAG_ON_BLOCK))
+        return blockerOn;
+
+      if (fn->hasFlag(FLAG_BEGIN_BLOCK) ||
+          fn->hasFlag(FLAG_COBEGIN_OR_COFORALL_BLOCK))
+        return blockerTasks;
+    }
+  }
+
+  std::vector<Expr*> stmts;
+
+  collect_stmts(loop, stmts);
+
+  for_vector(Expr, stmt, stmts)
+  {
+    if (stmt != loop && isLoopStmt(stmt))
+      return blockerLoop;
+  }
+
+  if (loop->isOrderIndependent() == false)
+    return "it is not order independent";
+
+  if (fNoVectorize)
+    return "vectorization hints are disabled (see --vectorize)";
+
+  for_vector(CallExpr, call, calls)
+  {
+    if (call->isPrimitive(PRIM_RT_ERROR))
+      return "it contains run-time checks (see --no-checks)";
+
+    if (FnSymbol* fn = call->resolvedFunction())
+    {
+      if (fn->hasFlag(FLAG_FUNCTION_TERMINATES_PROGRAM))
+        return "it contains run-time checks (see --no-checks)";
+
+      // A zippered iterator that is not a single loop is advanced through
+      // its iterator class one element at a time.
+      if (fn->_this != NULL &&
+          fn->_this->type->symbol->hasFlag(FLAG_ITERATOR_CLASS))
+        return "its iterator could not be inlined";
+
+      if (fn->hasFlag(FLAG_EXTERN) == false)
+        return astr("it calls '", fn->name, "'");
+    }
+  }
+
+  return NULL;
+}
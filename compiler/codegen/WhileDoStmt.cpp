@@ -44,6 +44,8 @@ GenRet WhileDoStmt::codegen()
 
   codegenStmt(this);
 
+  reportVectorization();
+
   if (outfile)
   {
 
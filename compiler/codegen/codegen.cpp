@@ -31,6 +31,7 @@
 #include "llvmDebug.h"
 #include "llvmUtil.h"
 #include "LayeredValueTable.h"
+#include "LoopStmt.h"
 #include "mysystem.h"
 #include "passes.h"
 #include "stlUtil.h"
@@ -52,6 +53,7 @@
 #endif
 
 #include <inttypes.h>
+#include <unistd.h>
 
 #include <algorithm>
 #include <cctype>
@@ -2314,22 +2316,22 @@ void codegen(void) {
     fprintf(mainfile.fptr, "#include \"%s.c\"\n", sCfgFname);
     fprintf(mainfile.fptr, "#include \"chpl__defn.c\"\n");
 
+    // With --incremental, every module is compiled as a separate
+    // translation unit, so the back-end compiles can run in parallel.
     std::vector<const char*> userFileName;
     if(fIncrementalCompilation) {
       ChainHashMap<char*, StringHashFns, int> fileNameHashMap;
       forv_Vec(ModuleSymbol, currentModule, allModules) {
         const char* filename = NULL;
         filename = generateFileName(fileNameHashMap, filename, currentModule->name);
-        if(currentModule->modTag == MOD_USER) {
-          fileinfo modulefile;
-          openCFile(&modulefile, filename, "c");
-          int modulePathLen = strlen(astr(modulefile.pathname));
-          char path[FILENAME_MAX];
-          strncpy(path, astr(modulefile.pathname), modulePathLen-2);
-          path[modulePathLen-2]='\0';
-          userFileName.push_back(astr(path));
-          closeCFile(&modulefile);
-        }
+        fileinfo modulefile;
+        openCFile(&modulefile, filename, "c");
+        int modulePathLen = strlen(astr(modulefile.pathname));
+        char path[FILENAME_MAX];
+        strncpy(path, astr(modulefile.pathname), modulePathLen-2);
+        path[modulePathLen-2]='\0';
+        userFileName.push_back(astr(path));
+        closeCFile(&modulefile);
       }
     }
 
@@ -2391,12 +2393,12 @@ void codegen(void) {
       fileinfo modulefile;
       openCFile(&modulefile, filename, "c");
       info->cfile = modulefile.fptr;
-      if(fIncrementalCompilation && (currentModule->modTag == MOD_USER))
+      if(fIncrementalCompilation)
         fprintf(modulefile.fptr, "#include \"chpl__header.h\"\n");
       currentModule->codegenDef();
       closeCFile(&modulefile);
 
-      if(!(fIncrementalCompilation && (currentModule->modTag == MOD_USER)))
+      if(!fIncrementalCompilation)
         fprintf(mainfile.fptr, "#include \"%s%s\"\n", filename, ".c");
     }
 
@@ -2420,6 +2422,11 @@ void codegen(void) {
   {
     fprintf(stderr, "Statements emitted: %d\n", gStmtCount);
   }
+
+  if (fReportVectorization)
+  {
+    LoopStmt::printVectorizationReport();
+  }
 }
 
 void makeBinary(void) {
@@ -2432,6 +2439,15 @@ void makeBinary(void) {
 #endif
   } else {
     const char* makeflags = printSystemCommands ? "-f " : "-s -f ";
+    if (fIncrementalCompilation) {
+      // Each module is its own translation unit, so compile them in
+      // parallel.
+      long jobs = fIncrementalMakeJobs;
+      if (jobs <= 0)
+        jobs = sysconf(_SC_NPROCESSORS_ONLN);
+      if (jobs > 1)
+        makeflags = astr("-j", istr((int) jobs), " ", makeflags);
+    }
     const char* command = astr(astr(CHPL_MAKE, " "),
                                makeflags,
                                getIntermediateDirName(), "/Makefile");
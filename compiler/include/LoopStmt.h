@@ -31,6 +31,9 @@ public:
 
   static Stmt*           findEnclosingLoopOrForall(Expr* expr);
 
+  // Print the verdicts gathered by reportVectorization()
+  static void            printVectorizationReport();
+
 public:
   virtual bool           isLoopStmt()                                    const;
 
@@ -51,6 +54,7 @@ protected:
   LabelSymbol*           mContinueLabel;
   bool                   mOrderIndependent;
   void                   codegenOrderIndependence();
+  void                   reportVectorization();
 
 
 private:
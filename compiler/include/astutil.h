@@ -63,6 +63,7 @@ void reset_ast_loc(BaseAST* destNode, BaseAST* sourceNode);
 // compute call sites FnSymbol::calls
 void compute_fn_call_sites(FnSymbol* fn);
 void compute_call_sites();
+void update_fn_call_sites(FnSymbol* fn);
 
 //
 // collect set of symbols and vector of SymExpr; can be used to
@@ -33,6 +33,7 @@
 #ifndef _BASEAST_H_
 #define _BASEAST_H_
 
+#include <cstddef>
 #include <ostream>
 #include <string>
 
@@ -284,6 +285,11 @@ public:
 
   static  const       std::string tabText;
 
+  // AST nodes are carved out of large chunks and recycled through
+  // per-size free lists rather than individually malloc'd and freed.
+  static void*      operator new   (size_t size);
+  static void       operator delete(void* ptr, size_t size);
+
 protected:
                     BaseAST(AstTag type);
   virtual          ~BaseAST();
@@ -101,9 +101,11 @@ public:
   static void        printBitVectorSets(BitVecVector& sets);
 
 
-  static BasicBlock*                          basicBlock;
-  static Map<LabelSymbol*, BasicBlock*>       labelMaps;
-  static Map<LabelSymbol*, BasicBlockVector*> gotoMaps;
+  // The builder state is per thread, so that the basic blocks of
+  // different functions can be built concurrently (see parallelFor.h).
+  static __thread BasicBlock*                          basicBlock;
+  static __thread Map<LabelSymbol*, BasicBlock*>*      labelMaps;
+  static __thread Map<LabelSymbol*, BasicBlockVector*>* gotoMaps;
 
 private:
   static void        buildBasicBlocks(FnSymbol* fn,
@@ -120,7 +122,7 @@ private:
   static void        removeEmptyBlocks(FnSymbol* fn);
   static bool        verifyBasicBlocks(FnSymbol* fn);
 
-  static int         nextID;
+  static __thread int nextID;
 
   //
   // Instance methods/variables
@@ -58,6 +58,8 @@ extern bool fNoInferConstRefs;
 extern bool fNoRemoteSerialization;
 extern bool fNoRemoveCopyCalls;
 extern bool fNoScalarReplacement;
+extern bool fNoStrengthReduction;
+extern bool fNoLocalityVersioning;
 extern bool fNoTupleCopyOpt;
 extern bool fNoOptimizeRangeIteration;
 extern bool fNoOptimizeLoopIterators;
@@ -72,6 +74,7 @@ extern int  optimize_on_clause_limit;
 extern int  scalar_replace_limit;
 extern int  inline_iter_yield_limit;
 extern int  tuple_copy_limit;
+extern int  rvf_value_limit;
 
 
 extern bool report_inlining;
@@ -118,6 +121,7 @@ extern const char* CHPL_LAUNCHER_SUBDIR;
 
 extern bool  printPasses;
 extern FILE* printPassesFile;
+extern char  printPassesProfile[FILENAME_MAX + 1];
 
 extern char fExplainCall[256];
 extern int  explainCallID;
@@ -132,6 +136,7 @@ extern bool fPrintCallGraph;
 extern bool fPrintCallStackOnError;
 extern bool fPrintIDonError;
 extern bool fPrintModuleResolution;
+extern bool fPrintResolutionStats;
 extern bool fPrintEmittedCodeSize;
 extern char fPrintStatistics[256];
 extern bool fPrintDispatch;
@@ -149,6 +154,10 @@ extern int  fMaxCIdentLen;
 
 extern bool llvmCodegen;
 
+// Should forall assignments aggregate their remote reads?
+extern bool fAutoAggregation;
+extern bool fForallFusion;
+
 // Is the cache for remote data enabled?
 extern bool fCacheRemote;
 
@@ -193,7 +202,13 @@ extern bool fReportInlinedIterators;
 extern bool fReportOrderIndependentLoops;
 extern bool fReportOptimizedOn;
 extern bool fReportPromotion;
+extern bool fReportRemoteValueForwarding;
 extern bool fReportScalarReplace;
+extern bool fReportAutoAggregation;
+extern bool fReportForallFusion;
+extern bool fReportStrengthReduction;
+extern bool fReportLocalityVersioning;
+extern bool fReportVectorization;
 extern bool fReportDeadBlocks;
 extern bool fReportDeadModules;
 
@@ -222,6 +237,10 @@ extern bool fMinimalModules;
 
 // Set to true if we want to enable incremental compilation.
 extern bool fIncrementalCompilation;
+extern int fIncrementalMakeJobs;
+
+// Number of worker threads for per-function analyses (0: one per processor).
+extern int fCompilerThreads;
 
 // Set to true if we want to use the experimental
 // Interactive Programming Environment (IPE) mode.
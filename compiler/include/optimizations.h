@@ -38,6 +38,8 @@
 class BaseAST;
 class BitVec;
 class BlockStmt;
+class CallExpr;
+class Expr;
 class FnSymbol;
 class Symbol;
 class SymExpr;
@@ -65,4 +67,13 @@ void inferConstRefs();
 
 void computeNoAliasSets();
 
+void  autoAggregation();
+Expr* lowerMaybeAggregateAssign(CallExpr* call);
+Expr* lowerMaybeAggregateAtomic(CallExpr* call);
+
+void  forallFusion();
+Expr* lowerFusible(CallExpr* call);
+
+void strengthReduceArrayAccesses(FnSymbol* fn);
+
 #endif
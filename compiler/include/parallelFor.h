@@ -0,0 +1,40 @@
+/*
+ * Copyright 2004-2018 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ * 
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * 
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _PARALLEL_FOR_H_
+#define _PARALLEL_FOR_H_
+
+//
+// Run task(i, arg) for every i in [0, n) on up to compilerThreads() worker
+// threads.  Indices are handed out dynamically, so a task must only write
+// state that belongs to its own index; callers then consume the results in
+// index order, which keeps the output independent of the thread count.
+//
+// The AST is not thread-safe: a task may read it but must not create,
+// remove, or relink nodes, and must not touch any other shared compiler
+// state.
+//
+typedef void (*ParallelForTask)(int i, void* arg);
+
+void parallelFor(int n, ParallelForTask task, void* arg);
+
+// The number of threads parallelFor() will use (--compiler-threads).
+int  compilerThreads();
+
+#endif
@@ -0,0 +1,42 @@
+/*
+ * Copyright 2004-2018 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _PASS_PROFILE_H_
+#define _PASS_PROFILE_H_
+
+//
+// Per-pass profile requested with --print-passes-profile.
+//
+// runPass() brackets each pass with the calls below; a pass may further
+// divide its primary work with passProfileSubPhase().  All of these are
+// no-ops unless a profile was requested.
+//
+
+void passProfileStartPass(const char* passName);
+void passProfileStartCheck();
+void passProfileStartCleanAst();
+void passProfileEndPass();
+
+// Start a named sub-phase within the current pass.  The sub-phase lasts
+// until the next call or the end of the pass's primary work.
+void passProfileSubPhase(const char* name);
+
+void passProfileWrite();
+
+#endif
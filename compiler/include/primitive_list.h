@@ -85,6 +85,9 @@
   PRIMITIVE_G(PRIM_OR_ASSIGN)
   PRIMITIVE_G(PRIM_XOR_ASSIGN)
   PRIMITIVE_R(PRIM_REDUCE_ASSIGN)
+  PRIMITIVE_R(PRIM_MAYBE_AGGREGATE_ASSIGN)
+  PRIMITIVE_R(PRIM_MAYBE_AGGREGATE_ATOMIC)
+  PRIMITIVE_R(PRIM_FUSIBLE)
 
   PRIMITIVE_G(PRIM_MIN)
   PRIMITIVE_G(PRIM_MAX)
@@ -738,6 +738,7 @@ extern VarSymbol *gDivZeroChecking;
 extern VarSymbol *gPrivatization;
 extern VarSymbol *gLocal;
 extern VarSymbol* gWarnUnstable;
+extern VarSymbol* gVectorize;
 extern VarSymbol *gNodeID;
 extern VarSymbol *gModuleInitIndentLevel;
 
@@ -22,6 +22,8 @@
 
 #include "vec.h"
 
+#include <cstdio>
+
 class BlockStmt;
 class CallExpr;
 class CallInfo;
@@ -40,4 +42,6 @@ BlockStmt* getInstantiationPoint(Expr* expr);
 
 void       visibleFunctionsClear();
 
+void       visibleFunctionsPrintStats(FILE* fp);
+
 #endif
@@ -617,6 +617,9 @@ checkResolveRemovedPrims(void) {
         case PRIM_IS_STAR_TUPLE_TYPE:
         case PRIM_IS_SUBTYPE:
         case PRIM_REDUCE_ASSIGN:
+        case PRIM_MAYBE_AGGREGATE_ASSIGN:
+        case PRIM_MAYBE_AGGREGATE_ATOMIC:
+        case PRIM_FUSIBLE:
         case PRIM_TUPLE_EXPAND:
         case PRIM_QUERY:
         case PRIM_QUERY_PARAM_FIELD:
@@ -108,12 +108,16 @@ bool ignore_user_errors = false;
 bool ignore_errors_for_pass = false;
 bool ignore_warnings = false;
 int  fcg = 0;
+bool fAutoAggregation = false;
 bool fCacheRemote = false;
 bool fFastFlag = false;
+bool fForallFusion = false;
 bool fUseNoinit = true;
 bool fNoCopyPropagation = false;
 bool fNoDeadCodeElimination = false;
 bool fNoScalarReplacement = false;
+bool fNoStrengthReduction = false;
+bool fNoLocalityVersioning = false;
 bool fNoTupleCopyOpt = false;
 bool fNoRemoteValueForwarding = false;
 bool fNoInferConstRefs = false;
@@ -141,6 +145,7 @@ bool fEnableTaskTracking = false;
 
 bool  printPasses     = false;
 FILE* printPassesFile = NULL;
+char  printPassesProfile[FILENAME_MAX + 1] = "";
 
 // flag for llvmWideOpt
 bool fLLVMWideOpt = false;
@@ -165,12 +170,15 @@ bool fNoRemoveEmptyRecords = true;
 bool fRemoveUnreachableBlocks = true;
 bool fMinimalModules = false;
 bool fIncrementalCompilation = false;
+int fIncrementalMakeJobs = 0;
+int fCompilerThreads = 0;
 bool fUseIPE         = false;
 
 int optimize_on_clause_limit = 20;
 int scalar_replace_limit = 8;
 int inline_iter_yield_limit = 10;
 int tuple_copy_limit = scalar_replace_limit;
+int rvf_value_limit = 16;
 bool fGenIDS = false;
 int fLinkStyle = LS_DEFAULT; // use backend compiler's default
 bool fUserSetLocal = false;
@@ -194,6 +202,7 @@ bool fPrintCallGraph = false;
 bool fPrintCallStackOnError = false;
 bool fPrintIDonError = false;
 bool fPrintModuleResolution = false;
+bool fPrintResolutionStats = false;
 bool fPrintEmittedCodeSize = false;
 char fPrintStatistics[256] = "";
 bool fPrintDispatch = false;
@@ -205,7 +214,13 @@ bool fReportInlinedIterators = false;
 bool fReportOrderIndependentLoops = false;
 bool fReportOptimizedOn = false;
 bool fReportPromotion = false;
+bool fReportRemoteValueForwarding = false;
 bool fReportScalarReplace = false;
+bool fReportAutoAggregation = false;
+bool fReportForallFusion = false;
+bool fReportStrengthReduction = false;
+bool fReportLocalityVersioning = false;
+bool fReportVectorization = false;
 bool fReportDeadBlocks = false;
 bool fReportDeadModules = false;
 bool fPermitUnhandledModuleErrors = false;
@@ -679,6 +694,8 @@ static void setFastFlag(const ArgumentDescription* desc, const char* unused) {
   fNoRemoteSerialization = false;
   fNoRemoveCopyCalls = false;
   fNoScalarReplacement = false;
+  fNoStrengthReduction = false;
+  fNoLocalityVersioning = false;
   fNoTupleCopyOpt = false;
   fNoPrivatization = false;
   fNoChecks = true;
@@ -712,6 +729,8 @@ static void setBaselineFlag(const ArgumentDescription* desc, const char* unused)
   //
   fBaseline = true;                   // --baseline
 
+  fAutoAggregation = false;          // --no-auto-aggregation
+  fForallFusion = false;              // --no-forall-fusion
   fNoCopyPropagation = true;          // --no-copy-propagation
   fNoDeadCodeElimination = true;      // --no-dead-code-elimination
   fNoFastFollowers = true;            // --no-fast-followers
@@ -721,6 +740,7 @@ static void setBaselineFlag(const ArgumentDescription* desc, const char* unused)
   fNoInline = true;                   // --no-inline
   fNoInlineIterators = true;          // --no-inline-iterators
   fNoLiveAnalysis = true;             // --no-live-analysis
+  fNoLocalityVersioning = true;       // --no-locality-versioning
   fNoOptimizeRangeIteration = true;   // --no-optimize-range-iteration
   fNoOptimizeLoopIterators = true;    // --no-optimize-loop-iterators
   fNoVectorize = true;                // --no-vectorize
@@ -729,6 +749,7 @@ static void setBaselineFlag(const ArgumentDescription* desc, const char* unused)
   fNoRemoteSerialization = true;      // --no-remote-serialization
   fNoRemoveCopyCalls = true;          // --no-remove-copy-calls
   fNoScalarReplacement = true;        // --no-scalar-replacement
+  fNoStrengthReduction = true;        // --no-strength-reduction
   fNoTupleCopyOpt = true;             // --no-tuple-copy-opt
   fNoPrivatization = true;            // --no-privatization
   fNoOptimizeOnClauses = true;        // --no-optimize-on-clauses
@@ -845,18 +866,21 @@ static ArgumentDescription arg_desc[] = {
  {"local", ' ', NULL, "Target one [many] locale[s]", "N", &fLocal, "CHPL_LOCAL", setLocal},
 
  {"", ' ', NULL, "Optimization Control Options", NULL, NULL, NULL, NULL},
+ {"auto-aggregation", ' ', NULL, "Enable [disable] aggregation of remote reads and atomic updates in forall loops", "N", &fAutoAggregation, "CHPL_AUTO_AGGREGATION", NULL},
  {"baseline", ' ', NULL, "Disable all Chapel optimizations", "F", &fBaseline, "CHPL_BASELINE", setBaselineFlag},
  {"cache-remote", ' ', NULL, "[Don't] enable cache for remote data", "N", &fCacheRemote, "CHPL_CACHE_REMOTE", setCacheEnable},
  {"copy-propagation", ' ', NULL, "Enable [disable] copy propagation", "n", &fNoCopyPropagation, "CHPL_DISABLE_COPY_PROPAGATION", NULL},
  {"dead-code-elimination", ' ', NULL, "Enable [disable] dead code elimination", "n", &fNoDeadCodeElimination, "CHPL_DISABLE_DEAD_CODE_ELIMINATION", NULL},
  {"fast", ' ', NULL, "Use fast default settings", "F", &fFastFlag, "CHPL_FAST", setFastFlag},
  {"fast-followers", ' ', NULL, "Enable [disable] fast followers", "n", &fNoFastFollowers, "CHPL_DISABLE_FAST_FOLLOWERS", NULL},
+ {"forall-fusion", ' ', NULL, "Enable [disable] fusion of adjacent forall loops and promoted statements", "N", &fForallFusion, "CHPL_FORALL_FUSION", NULL},
  {"ieee-float", ' ', NULL, "Generate code that is strict [lax] with respect to IEEE compliance", "N", &fieeefloat, "CHPL_IEEE_FLOAT", setFloatOptFlag},
  {"ignore-local-classes", ' ', NULL, "Disable [enable] local classes", "N", &fIgnoreLocalClasses, NULL, NULL},
  {"inline", ' ', NULL, "Enable [disable] function inlining", "n", &fNoInline, NULL, NULL},
  {"inline-iterators", ' ', NULL, "Enable [disable] iterator inlining", "n", &fNoInlineIterators, "CHPL_DISABLE_INLINE_ITERATORS", NULL},
  {"inline-iterators-yield-limit", ' ', "<limit>", "Limit number of yields permitted in inlined iterators", "I", &inline_iter_yield_limit, "CHPL_INLINE_ITER_YIELD_LIMIT", NULL},
  {"live-analysis", ' ', NULL, "Enable [disable] live variable analysis", "n", &fNoLiveAnalysis, "CHPL_DISABLE_LIVE_ANALYSIS", NULL},
+ {"locality-versioning", ' ', NULL, "Enable [disable] versioning of loops on the locality of the wide pointers they access", "n", &fNoLocalityVersioning, "CHPL_DISABLE_LOCALITY_VERSIONING", NULL},
  {"loop-invariant-code-motion", ' ', NULL, "Enable [disable] loop invariant code motion", "n", &fNoLoopInvariantCodeMotion, NULL, NULL},
  {"optimize-range-iteration", ' ', NULL, "Enable [disable] optimization of iteration over anonymous ranges", "n", &fNoOptimizeRangeIteration, "CHPL_DISABLE_OPTIMIZE_RANGE_ITERATION", NULL},
  {"optimize-loop-iterators", ' ', NULL, "Enable [disable] optimization of iterators composed of a single loop", "n", &fNoOptimizeLoopIterators, "CHPL_DISABLE_OPTIMIZE_LOOP_ITERATORS", NULL},
@@ -864,10 +888,12 @@ static ArgumentDescription arg_desc[] = {
  {"optimize-on-clause-limit", ' ', "<limit>", "Limit recursion depth of on clause optimization search", "I", &optimize_on_clause_limit, "CHPL_OPTIMIZE_ON_CLAUSE_LIMIT", NULL},
  {"privatization", ' ', NULL, "Enable [disable] privatization of distributed arrays and domains", "n", &fNoPrivatization, "CHPL_DISABLE_PRIVATIZATION", NULL},
  {"remote-value-forwarding", ' ', NULL, "Enable [disable] remote value forwarding", "n", &fNoRemoteValueForwarding, "CHPL_DISABLE_REMOTE_VALUE_FORWARDING", NULL},
+ {"remote-value-forwarding-limit", ' ', "<limit>", "Limit on the number of scalar fields in records and tuples copied by remote value forwarding", "I", &rvf_value_limit, "CHPL_RVF_VALUE_LIMIT", NULL},
  {"remote-serialization", ' ', NULL, "Enable [disable] serialization for remote consts", "n", &fNoRemoteSerialization, "CHPL_DISABLE_REMOTE_SERIALIZATION", NULL},
  {"remove-copy-calls", ' ', NULL, "Enable [disable] remove copy calls", "n", &fNoRemoveCopyCalls, "CHPL_DISABLE_REMOVE_COPY_CALLS", NULL},
  {"scalar-replacement", ' ', NULL, "Enable [disable] scalar replacement", "n", &fNoScalarReplacement, "CHPL_DISABLE_SCALAR_REPLACEMENT", NULL},
  {"scalar-replace-limit", ' ', "<limit>", "Limit on the size of tuples being replaced during scalar replacement", "I", &scalar_replace_limit, "CHPL_SCALAR_REPLACE_TUPLE_LIMIT", NULL},
+ {"strength-reduction", ' ', NULL, "Enable [disable] strength reduction of array accesses in loops", "n", &fNoStrengthReduction, "CHPL_DISABLE_STRENGTH_REDUCTION", NULL},
  {"tuple-copy-opt", ' ', NULL, "Enable [disable] tuple (memcpy) optimization", "n", &fNoTupleCopyOpt, "CHPL_DISABLE_TUPLE_COPY_OPT", NULL},
  {"tuple-copy-limit", ' ', "<limit>", "Limit on the size of tuples considered for optimization", "I", &tuple_copy_limit, "CHPL_TUPLE_COPY_LIMIT", NULL},
  {"use-noinit", ' ', NULL, "Enable [disable] ability to skip default initialization through the keyword noinit", "N", &fUseNoinit, NULL, NULL},
@@ -913,6 +939,7 @@ static ArgumentDescription arg_desc[] = {
  {"print-commands", ' ', NULL, "[Don't] print system commands", "N", &printSystemCommands, "CHPL_PRINT_COMMANDS", NULL},
  {"print-passes", ' ', NULL, "[Don't] print compiler passes", "N", &printPasses, "CHPL_PRINT_PASSES", NULL},
  {"print-passes-file", ' ', "<filename>", "Print compiler passes to <filename>", "S", NULL, "CHPL_PRINT_PASSES_FILE", setPrintPassesFile},
+ {"print-passes-profile", ' ', "<filename>", "Write per-pass time, memory and AST statistics to <filename> as CSV, or as JSON if it ends in .json", "P", printPassesProfile, "CHPL_PRINT_PASSES_PROFILE", NULL},
 
  {"", ' ', NULL, "Miscellaneous Options", NULL, NULL, NULL, NULL},
 // Support for extern { c-code-here } blocks could be toggled with this
@@ -983,18 +1010,25 @@ static ArgumentDescription arg_desc[] = {
  {"debug-short-loc", ' ', NULL, "Display long [short] location in certain debug outputs", "N", &debugShortLoc, "CHPL_DEBUG_SHORT_LOC", NULL},
  {"print-emitted-code-size", ' ', NULL, "Print emitted code size", "F", &fPrintEmittedCodeSize, NULL, NULL},
  {"print-module-resolution", ' ', NULL, "Print name of module being resolved", "F", &fPrintModuleResolution, "CHPL_PRINT_MODULE_RESOLUTION", NULL},
+ {"print-resolution-stats", ' ', NULL, "Print function resolution statistics", "F", &fPrintResolutionStats, "CHPL_PRINT_RESOLUTION_STATS", NULL},
  {"print-dispatch", ' ', NULL, "Print dynamic dispatch table", "F", &fPrintDispatch, NULL, NULL},
  {"print-statistics", ' ', "[n|k|t]", "Print AST statistics", "S256", fPrintStatistics, NULL, NULL},
  {"report-aliases", ' ', NULL, "Report aliases in user code", "N", &fReportAliases, NULL, NULL},
  {"report-inlining", ' ', NULL, "Print inlined functions", "F", &report_inlining, NULL, NULL},
  {"report-dead-blocks", ' ', NULL, "Print dead block removal stats", "F", &fReportDeadBlocks, NULL, NULL},
  {"report-dead-modules", ' ', NULL, "Print dead module removal stats", "F", &fReportDeadModules, NULL, NULL},
+ {"report-locality-versioning", ' ', NULL, "Print the loops versioned on the locality of wide pointers", "F", &fReportLocalityVersioning, NULL, NULL},
  {"report-optimized-loop-iterators", ' ', NULL, "Print stats on optimized single loop iterators", "F", &fReportOptimizedLoopIterators, NULL, NULL},
  {"report-inlined-iterators", ' ', NULL, "Print stats on inlined iterators", "F", &fReportInlinedIterators, NULL, NULL},
  {"report-order-independent-loops", ' ', NULL, "Print stats on order independent loops", "F", &fReportOrderIndependentLoops, NULL, NULL},
  {"report-optimized-on", ' ', NULL, "Print information about on clauses that have been optimized for potential fast remote fork operation", "F", &fReportOptimizedOn, NULL, NULL},
  {"report-promotion", ' ', NULL, "Print information about scalar promotion", "F", &fReportPromotion, NULL, NULL},
+ {"report-remote-value-forwarding", ' ', NULL, "Print the variables forwarded by value to on clauses", "F", &fReportRemoteValueForwarding, NULL, NULL},
  {"report-scalar-replace", ' ', NULL, "Print scalar replacement stats", "F", &fReportScalarReplace, NULL, NULL},
+ {"report-forall-fusion", ' ', NULL, "Print information about fused forall loops and promoted statements", "F", &fReportForallFusion, NULL, NULL},
+ {"report-auto-aggregation", ' ', NULL, "Print information about forall loops using remote read or atomic aggregation", "F", &fReportAutoAggregation, NULL, NULL},
+ {"report-strength-reduction", ' ', NULL, "Print information about array accesses strength-reduced in loops", "F", &fReportStrengthReduction, NULL, NULL},
+ {"report-vectorization", ' ', NULL, "Print whether each loop is vectorizable and, if not, why", "F", &fReportVectorization, NULL, NULL},
  {"default-unmanaged", ' ', NULL, "Enable [disable] class type defaulting to unmanaged", "N", &fDefaultUnmanaged, "CHPL_DEFAULT_UNMANAGED", NULL},
  {"legacy-new", ' ', NULL, "Enable [disable] 'new SomeClass' legacy behavior", "N", &fLegacyNew, "CHPL_LEGACY_NEW", NULL},
 
@@ -1033,6 +1067,8 @@ static ArgumentDescription arg_desc[] = {
  {"remove-unreachable-blocks", ' ', NULL, "[Don't] remove unreachable blocks after resolution", "N", &fRemoveUnreachableBlocks, "CHPL_REMOVE_UNREACHABLE_BLOCKS", NULL},
  {"replace-array-accesses-with-ref-temps", ' ', NULL, "Enable [disable] replacing array accesses with reference temps (experimental)", "N", &fReplaceArrayAccessesWithRefTemps, NULL, NULL },
  {"incremental", ' ', NULL, "Enable [disable] using incremental compilation", "N", &fIncrementalCompilation, "CHPL_INCREMENTAL_COMP", NULL},
+ {"incremental-make-jobs", ' ', "<n>", "Number of parallel back-end compiles with --incremental, 0 for one per processor", "I", &fIncrementalMakeJobs, "CHPL_INCREMENTAL_MAKE_JOBS", NULL},
+ {"compiler-threads", ' ', "<n>", "Number of threads for per-function compiler analyses, 0 for one per processor", "I", &fCompilerThreads, "CHPL_COMPILER_THREADS", NULL},
  {"minimal-modules", ' ', NULL, "Enable [disable] using minimal modules",               "N", &fMinimalModules, "CHPL_MINIMAL_MODULES", NULL},
  {"print-chpl-settings", ' ', NULL, "Print current chapel settings and exit", "F", &fPrintChplSettings, NULL,NULL},
  {"stop-after-pass", ' ', "<passname>", "Stop compilation after reaching this pass", "S128", &stopAfterPass, "CHPL_STOP_AFTER_PASS", NULL},
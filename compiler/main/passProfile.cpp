@@ -0,0 +1,322 @@
+/*
+ * Copyright 2004-2018 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "passProfile.h"
+
+#include "baseAST.h"
+#include "driver.h"
+#include "misc.h"
+#include "timer.h"
+
+#include <cstdio>
+#include <cstring>
+#include <sys/resource.h>
+#include <vector>
+
+/************************************* | **************************************
+*                                                                             *
+* Collects, for every pass, the time spent in its three phases (see           *
+* PhaseTracker.h), the peak RSS at the end of the pass, the number of AST     *
+* nodes allocated during the pass and freed by its cleanAst, and the number   *
+* of live nodes of each kind afterwards.  Passes may record sub-phases of     *
+* their primary work, which get their own time, peak RSS and allocation      *
+* counts.                                                                     *
+*                                                                             *
+* The profile is written when the passes are complete, either as CSV with    *
+* one "pass,metric,value" line per measurement (so that a .perfkeys file can  *
+* pick out any single value with a "pass,metric," key) or as JSON.            *
+*                                                                             *
+************************************** | *************************************/
+
+#define count_gvec(type) g##type##s.n
+#define name_gvec(type)  #type
+#define comma_sep        ,
+
+static const char* sAstKindNames[] = { foreach_ast_sep(name_gvec, comma_sep) };
+
+static const int   sNumAstKinds    = sizeof(sAstKindNames) /
+                                     sizeof(sAstKindNames[0]);
+
+struct SubPhaseProfile {
+  const char*      name;
+  unsigned long    usecs;
+  long             peakRssKB;
+  int              astAllocated;
+};
+
+struct PassProfile {
+  const char*      name;
+  unsigned long    mainUsecs;
+  unsigned long    checkUsecs;
+  unsigned long    cleanUsecs;
+  long             peakRssKB;
+  int              astAllocated;
+  int              astFreed;
+  int              astLive;
+  int              astLiveByKind[sNumAstKinds];
+
+  std::vector<SubPhaseProfile> subPhases;
+};
+
+static std::vector<PassProfile> sPasses;
+
+static Timer         sTimer;
+static unsigned long sPhaseStart   = 0;
+static int           sPassFirstId  = 0;
+static int           sLiveBeforeCleanAst = 0;
+
+static bool          sInSubPhase   = false;
+static unsigned long sSubPhaseStart = 0;
+static int           sSubPhaseFirstId = 0;
+
+static bool profiling() {
+  return printPassesProfile[0] != '\0';
+}
+
+static long peakRssKB() {
+  struct rusage usage;
+
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+
+#ifdef __APPLE__
+  // ru_maxrss is in bytes on Mac OS X and in kilobytes elsewhere
+  return usage.ru_maxrss / 1024;
+#else
+  return usage.ru_maxrss;
+#endif
+}
+
+static int countLiveAsts(int* byKind) {
+  int counts[] = { foreach_ast_sep(count_gvec, comma_sep) };
+  int total    = 0;
+
+  for (int i = 0; i < sNumAstKinds; i++) {
+    if (byKind != NULL)
+      byKind[i] = counts[i];
+
+    total = total + counts[i];
+  }
+
+  return total;
+}
+
+static unsigned long endPhase() {
+  unsigned long now     = sTimer.elapsedUsecs();
+  unsigned long elapsed = (now > sPhaseStart) ? now - sPhaseStart : 0;
+
+  sPhaseStart = now;
+
+  return elapsed;
+}
+
+static void endSubPhase() {
+  if (sInSubPhase == true) {
+    unsigned long   now = sTimer.elapsedUsecs();
+    SubPhaseProfile& sub = sPasses.back().subPhases.back();
+
+    sub.usecs        = (now > sSubPhaseStart) ? now - sSubPhaseStart : 0;
+    sub.peakRssKB    = peakRssKB();
+    sub.astAllocated = lastNodeIDUsed() - sSubPhaseFirstId;
+
+    sInSubPhase      = false;
+  }
+}
+
+void passProfileStartPass(const char* passName) {
+  if (profiling() == true) {
+    PassProfile pass;
+
+    if (sPasses.size() == 0)
+      sTimer.start();
+
+    memset(&pass.astLiveByKind, 0, sizeof(pass.astLiveByKind));
+
+    pass.name         = passName;
+    pass.mainUsecs    = 0;
+    pass.checkUsecs   = 0;
+    pass.cleanUsecs   = 0;
+    pass.peakRssKB    = 0;
+    pass.astAllocated = 0;
+    pass.astFreed     = 0;
+    pass.astLive      = 0;
+
+    sPasses.push_back(pass);
+
+    sPhaseStart  = sTimer.elapsedUsecs();
+    sPassFirstId = lastNodeIDUsed();
+  }
+}
+
+void passProfileSubPhase(const char* name) {
+  if (profiling() == true && sPasses.size() > 0) {
+    SubPhaseProfile sub;
+
+    endSubPhase();
+
+    sub.name         = name;
+    sub.usecs        = 0;
+    sub.peakRssKB    = 0;
+    sub.astAllocated = 0;
+
+    sPasses.back().subPhases.push_back(sub);
+
+    sInSubPhase      = true;
+    sSubPhaseStart   = sTimer.elapsedUsecs();
+    sSubPhaseFirstId = lastNodeIDUsed();
+  }
+}
+
+void passProfileStartCheck() {
+  if (profiling() == true) {
+    endSubPhase();
+
+    sPasses.back().mainUsecs = endPhase();
+  }
+}
+
+void passProfileStartCleanAst() {
+  if (profiling() == true) {
+    sPasses.back().checkUsecs = endPhase();
+
+    sLiveBeforeCleanAst = countLiveAsts(NULL);
+  }
+}
+
+void passProfileEndPass() {
+  if (profiling() == true) {
+    PassProfile& pass = sPasses.back();
+
+    pass.cleanUsecs   = endPhase();
+    pass.peakRssKB    = peakRssKB();
+    pass.astAllocated = lastNodeIDUsed() - sPassFirstId;
+    pass.astLive      = countLiveAsts(pass.astLiveByKind);
+    pass.astFreed     = sLiveBeforeCleanAst - pass.astLive;
+  }
+}
+
+/************************************* | **************************************
+*                                                                             *
+* Output                                                                      *
+*                                                                             *
+************************************** | *************************************/
+
+static void writeCsv(FILE* fp) {
+  fprintf(fp, "pass,metric,value\n");
+
+  for (size_t i = 0; i < sPasses.size(); i++) {
+    const PassProfile& pass = sPasses[i];
+
+    fprintf(fp, "%s,mainSecs,%.3f\n",     pass.name, pass.mainUsecs  / 1e6);
+    fprintf(fp, "%s,checkSecs,%.3f\n",    pass.name, pass.checkUsecs / 1e6);
+    fprintf(fp, "%s,cleanAstSecs,%.3f\n", pass.name, pass.cleanUsecs / 1e6);
+    fprintf(fp, "%s,peakRssKB,%ld\n",     pass.name, pass.peakRssKB);
+    fprintf(fp, "%s,astAllocated,%d\n",   pass.name, pass.astAllocated);
+    fprintf(fp, "%s,astFreed,%d\n",       pass.name, pass.astFreed);
+    fprintf(fp, "%s,astLive,%d\n",        pass.name, pass.astLive);
+
+    for (int k = 0; k < sNumAstKinds; k++) {
+      fprintf(fp, "%s,astLive.%s,%d\n",
+              pass.name, sAstKindNames[k], pass.astLiveByKind[k]);
+    }
+
+    for (size_t j = 0; j < pass.subPhases.size(); j++) {
+      const SubPhaseProfile& sub = pass.subPhases[j];
+
+      fprintf(fp, "%s.%s,secs,%.3f\n",
+              pass.name, sub.name, sub.usecs / 1e6);
+      fprintf(fp, "%s.%s,peakRssKB,%ld\n",
+              pass.name, sub.name, sub.peakRssKB);
+      fprintf(fp, "%s.%s,astAllocated,%d\n",
+              pass.name, sub.name, sub.astAllocated);
+    }
+  }
+}
+
+static void writeJson(FILE* fp) {
+  fprintf(fp, "{\n  \"passes\": [");
+
+  for (size_t i = 0; i < sPasses.size(); i++) {
+    const PassProfile& pass = sPasses[i];
+
+    fprintf(fp, "%s\n    {\n", (i == 0) ? "" : ",");
+    fprintf(fp, "      \"name\": \"%s\",\n",       pass.name);
+    fprintf(fp, "      \"mainSecs\": %.3f,\n",     pass.mainUsecs  / 1e6);
+    fprintf(fp, "      \"checkSecs\": %.3f,\n",    pass.checkUsecs / 1e6);
+    fprintf(fp, "      \"cleanAstSecs\": %.3f,\n", pass.cleanUsecs / 1e6);
+    fprintf(fp, "      \"peakRssKB\": %ld,\n",     pass.peakRssKB);
+    fprintf(fp, "      \"astAllocated\": %d,\n",   pass.astAllocated);
+    fprintf(fp, "      \"astFreed\": %d,\n",       pass.astFreed);
+    fprintf(fp, "      \"astLive\": %d,\n",        pass.astLive);
+
+    fprintf(fp, "      \"astLiveByKind\": {");
+
+    for (int k = 0; k < sNumAstKinds; k++) {
+      fprintf(fp, "%s\n        \"%s\": %d",
+              (k == 0) ? "" : ",", sAstKindNames[k], pass.astLiveByKind[k]);
+    }
+
+    fprintf(fp, "\n      },\n");
+
+    fprintf(fp, "      \"subPhases\": [");
+
+    for (size_t j = 0; j < pass.subPhases.size(); j++) {
+      const SubPhaseProfile& sub = pass.subPhases[j];
+
+      fprintf(fp, "%s\n        { \"name\": \"%s\", \"secs\": %.3f, "
+                  "\"peakRssKB\": %ld, \"astAllocated\": %d }",
+              (j == 0) ? "" : ",",
+              sub.name, sub.usecs / 1e6, sub.peakRssKB, sub.astAllocated);
+    }
+
+    fprintf(fp, "%s]\n    }", (pass.subPhases.size() == 0) ? "" : "\n      ");
+  }
+
+  fprintf(fp, "\n  ]\n}\n");
+}
+
+void passProfileWrite() {
+  if (profiling() == true && sPasses.size() > 0) {
+    const char* fileName = printPassesProfile;
+    size_t      len      = strlen(fileName);
+    bool        json     = len > 5 && strcmp(fileName + len - 5, ".json") == 0;
+
+    if (strcmp(fileName, "-") == 0) {
+      writeCsv(stdout);
+      fflush(stdout);
+
+    } else {
+      FILE* fp = fopen(fileName, "w");
+
+      if (fp == NULL) {
+        USR_WARN("Error opening pass profile file: %s.", fileName);
+
+      } else {
+        if (json == true)
+          writeJson(fp);
+        else
+          writeCsv(fp);
+
+        fclose(fp);
+      }
+    }
+
+    sPasses.clear();
+  }
+}
@@ -23,6 +23,7 @@
 #include "driver.h"
 #include "log.h"
 #include "parser.h"
+#include "passProfile.h"
 #include "passes.h"
 #include "PhaseTracker.h"
 
@@ -188,6 +189,8 @@ void runPasses(PhaseTracker& tracker, bool isChpldoc) {
     }
   }
 
+  passProfileWrite();
+
   destroyAst();
   teardownLogfiles();
 }
@@ -200,6 +203,7 @@ static void runPass(PhaseTracker& tracker, size_t passIndex, bool isChpldoc) {
   //
 
   tracker.StartPhase(info->name, PhaseTracker::kPrimary);
+  passProfileStartPass(info->name);
 
   if (fPrintStatistics[0] != '\0' && passIndex > 0)
     printStatistics("clean");
@@ -221,6 +225,7 @@ static void runPass(PhaseTracker& tracker, size_t passIndex, bool isChpldoc) {
   // An optional verify pass
   //
   tracker.StartPhase(info->name, PhaseTracker::kVerify);
+  passProfileStartCheck();
   (*(info->checkFunction))(); // Run per-pass check function.
 
   //
@@ -229,11 +234,15 @@ static void runPass(PhaseTracker& tracker, size_t passIndex, bool isChpldoc) {
   // writing, it didn't work if we hadn't parsed all the 'use'd
   // modules.
   //
+  passProfileStartCleanAst();
+
   if (!isChpldoc) {
     tracker.StartPhase(info->name, PhaseTracker::kCleanAst);
     cleanAst();
   }
 
+  passProfileEndPass();
+
   if (printPasses == true || printPassesFile != 0) {
     tracker.ReportPass();
   }
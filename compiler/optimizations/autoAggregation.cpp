@@ -0,0 +1,436 @@
+/*
+ * Copyright 2004-2018 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//
+// Aggregation of remote reads in forall loops (--auto-aggregation)
+//
+// A forall loop whose body is a single assignment
+//
+//   forall i in ... do B[i] = A[expr];
+//
+// reads one element of A per iteration.  When A is distributed, each
+// non-local read is its own fine-grained GET.  Before normalization
+// such a loop is rewritten into
+//
+//   forall i in ... with (var chpl_agg = chpl__srcAggregatorFor(A)) do
+//     __primitive("maybe aggregate assign", chpl_agg, B[i], A[expr]);
+//
+// Once the types are known, resolution turns the primitive either into
+// 'chpl_agg.copy(B[i], A[expr])' or back into 'B[i] = A[expr]'.  The
+// task-private aggregator (modules/internal/ChapelAutoAggregation.chpl)
+// records the addresses of the remote elements, grouped by owning
+// locale, and fetches each group with one round trip when its buffer
+// fills up or when the task finishes.
+//
+// The aggregator tests locality at run time, so the rewrite does not need
+// to prove anything about the distributions of A or B.  It does defer the
+// store into B[i] until the end of the task, which is why the loop body
+// must consist of nothing but the assignment and why the left-hand side
+// must be indexed by the loop index alone.
+//
+// A forall loop whose body is a single atomic update
+//
+//   forall x in ... do A[expr].add(v);
+//
+// issues one network atomic, or one active message, per remote element.
+// It is rewritten the same way, with a task-private atomic aggregator
+// created by 'chpl__atomicAggregatorFor(A, "add")' and the primitive
+// "maybe aggregate atomic".  The aggregator buffers the addresses and
+// operands per owning locale and applies each group with one on-statement
+// on that locale.  The updates 'sub', 'or', 'and' and 'xor', and the
+// 'fetch' variants whose result is dropped, are handled the same way.
+// Deferring the updates is only safe because the iterations of a forall
+// are unordered and nothing else in the body can observe A, so the index
+// and operand expressions must not mention A either.
+//
+
+#include "optimizations.h"
+
+#include "astutil.h"
+#include "driver.h"
+#include "expr.h"
+#include "ForallStmt.h"
+#include "resolution.h"
+#include "stmt.h"
+#include "stringutil.h"
+#include "symbol.h"
+#include "type.h"
+
+#include <cstring>
+#include <set>
+#include <string>
+#include <vector>
+
+static Symbol*   forallIndexVar(ForallStmt* fs);
+static Expr*     soleStatement(BlockStmt* body);
+static Symbol*   indexedArray(Expr* expr);
+static void      maybeAggregateRead(ForallStmt* fs, CallExpr* assign);
+static void      aggregateAssignment(ForallStmt* fs, CallExpr* assign);
+static const char* atomicUpdateOp(CallExpr* call);
+static void      aggregateAtomicUpdate(ForallStmt* fs,
+                                       CallExpr*   call,
+                                       const char* op);
+static bool      canAggregateRead(Symbol* agg, Symbol* lhs, Symbol* rhs);
+static bool      canAggregateAtomic(Symbol* agg, Symbol* elt);
+static void      reportAggregation(CallExpr* call, const char* what);
+
+/************************************* | **************************************
+*                                                                             *
+* Pre-normalization: find candidate assignments in user foralls.              *
+*                                                                             *
+************************************** | *************************************/
+
+void autoAggregation() {
+  if (fAutoAggregation == false || fLocal == true) {
+    return;
+  }
+
+  forv_Vec(ForallStmt, fs, gForallStmts) {
+    if (fs->inTree()                          == false ||
+        fs->getModule()->modTag               != MOD_USER ||
+        fs->createdFromForLoop()              == true) {
+      continue;
+    }
+
+    if (CallExpr* stmt = toCallExpr(soleStatement(fs->loopBody()))) {
+      if (stmt->isNamed("=") == true) {
+        maybeAggregateRead(fs, stmt);
+
+      } else if (const char* op = atomicUpdateOp(stmt)) {
+        aggregateAtomicUpdate(fs, stmt, op);
+      }
+    }
+  }
+}
+
+static void maybeAggregateRead(ForallStmt* fs, CallExpr* assign) {
+  Symbol* idx = forallIndexVar(fs);
+
+  if (idx == NULL || fs->zippered() == true) {
+    return;
+  }
+
+  CallExpr* lhs = toCallExpr(assign->get(1));
+  Symbol*   dst = indexedArray(lhs);
+  Symbol*   src = indexedArray(assign->get(2));
+
+  if (dst == NULL || src == NULL || dst == src) {
+    return;
+  }
+
+  // B[i]: each iteration writes its own element
+  if (lhs->numActuals() != 1) {
+    return;
+  }
+
+  if (SymExpr* se = toSymExpr(lhs->get(1))) {
+    if (se->symbol() == idx) {
+      aggregateAssignment(fs, assign);
+    }
+  }
+}
+
+// The index variable of a non-zippered forall, unless it is destructured.
+static Symbol* forallIndexVar(ForallStmt* fs) {
+  Symbol* retval = NULL;
+
+  if (fs->numInductionVars() == 1) {
+    DefExpr* def = toDefExpr(fs->inductionVariables().head);
+
+    if (def->sym->hasFlag(FLAG_TEMP) == false) {
+      retval = def->sym;
+    }
+  }
+
+  return retval;
+}
+
+// The only statement in 'body', looking through nested plain blocks.
+static Expr* soleStatement(BlockStmt* body) {
+  Expr* retval = NULL;
+
+  if (body->body.length == 1) {
+    Expr* stmt = body->body.head;
+
+    if (BlockStmt* block = toBlockStmt(stmt)) {
+      if (block->isRealBlockStmt()     == true &&
+          block->blockInfoGet()        == NULL &&
+          block->useList               == NULL &&
+          block->byrefVars             == NULL) {
+        retval = soleStatement(block);
+      }
+
+    } else {
+      retval = stmt;
+    }
+  }
+
+  return retval;
+}
+
+// X for an expression X[...] where X is a variable, otherwise NULL.
+// After scope resolution a call through a variable has a SymExpr base
+// whereas a call to a function still has an UnresolvedSymExpr base.
+static Symbol* indexedArray(Expr* expr) {
+  Symbol* retval = NULL;
+
+  if (CallExpr* call = toCallExpr(expr)) {
+    if (call->numActuals() > 0 && call->partialTag == false) {
+      if (SymExpr* base = toSymExpr(call->baseExpr)) {
+        if (isLcnSymbol(base->symbol()) == true) {
+          retval = base->symbol();
+        }
+      }
+    }
+  }
+
+  return retval;
+}
+
+static void aggregateAssignment(ForallStmt* fs, CallExpr* assign) {
+  SET_LINENO(assign);
+
+  Symbol*          src  = indexedArray(assign->get(2));
+  CallExpr*        init = new CallExpr("chpl__srcAggregatorFor", src);
+  ShadowVarSymbol* agg  =
+    ShadowVarSymbol::buildForPrefix(SVP_VAR,
+                                    new UnresolvedSymExpr("chpl_agg"),
+                                    NULL,
+                                    init);
+
+  fs->shadowVariables().insertAtTail(agg->defPoint);
+
+  Expr* rhs = assign->get(2)->remove();
+  Expr* lhs = assign->get(1)->remove();
+
+  assign->replace(new CallExpr(PRIM_MAYBE_AGGREGATE_ASSIGN, agg, lhs, rhs));
+}
+
+//
+// For a call 'A[expr].op(v)' that updates an element of A without using
+// the result, the name of the update its aggregator applies, else NULL.
+// Before normalization the call's base is the dot expression 'A[expr].op'.
+//
+static const char* atomicUpdateOp(CallExpr* call) {
+  static const char* updateOps[][2] = {
+    { "add",      "add" }, { "fetchAdd", "add" },
+    { "sub",      "sub" }, { "fetchSub", "sub" },
+    { "or",       "or"  }, { "fetchOr",  "or"  },
+    { "and",      "and" }, { "fetchAnd", "and" },
+    { "xor",      "xor" }, { "fetchXor", "xor" }
+  };
+
+  CallExpr*   dot    = toCallExpr(call->baseExpr);
+  const char* retval = NULL;
+
+  if (dot                       == NULL  ||
+      dot->isNamed(".")         == false ||
+      call->numActuals()        != 1     ||
+      isNamedExpr(call->get(1)) == true) {
+    return NULL;
+  }
+
+  Symbol*     arr    = indexedArray(dot->get(1));
+  const char* method = NULL;
+
+  if (arr == NULL || get_string(dot->get(2), &method) == false) {
+    return NULL;
+  }
+
+  for (size_t i = 0; i < sizeof(updateOps) / sizeof(updateOps[0]); i++) {
+    if (strcmp(method, updateOps[i][0]) == 0) {
+      retval = updateOps[i][1];
+    }
+  }
+
+  if (retval != NULL) {
+    std::vector<SymExpr*> symExprs;
+
+    collectSymExprs(call->get(1), symExprs);
+
+    for_actuals(actual, toCallExpr(dot->get(1))) {
+      collectSymExprs(actual, symExprs);
+    }
+
+    for_vector(SymExpr, se, symExprs) {
+      if (se->symbol() == arr) {
+        retval = NULL;
+      }
+    }
+  }
+
+  return retval;
+}
+
+static void aggregateAtomicUpdate(ForallStmt* fs,
+                                  CallExpr*   call,
+                                  const char* op) {
+  SET_LINENO(call);
+
+  CallExpr*        dot  = toCallExpr(call->baseExpr);
+  Symbol*          arr  = indexedArray(dot->get(1));
+  CallExpr*        init = new CallExpr("chpl__atomicAggregatorFor",
+                                       arr,
+                                       new_StringSymbol(op));
+  ShadowVarSymbol* agg  =
+    ShadowVarSymbol::buildForPrefix(SVP_VAR,
+                                    new UnresolvedSymExpr("chpl_agg"),
+                                    NULL,
+                                    init);
+
+  fs->shadowVariables().insertAtTail(agg->defPoint);
+
+  Expr* method = dot->get(2)->remove();
+  Expr* elt    = dot->get(1)->remove();
+  Expr* value  = call->get(1)->remove();
+
+  call->replace(new CallExpr(PRIM_MAYBE_AGGREGATE_ATOMIC,
+                             agg, method, elt, value));
+}
+
+/************************************* | **************************************
+*                                                                             *
+* Resolution: aggregate if the types allow it, otherwise keep the original.   *
+*                                                                             *
+************************************** | *************************************/
+
+Expr* lowerMaybeAggregateAssign(CallExpr* call) {
+  SymExpr*  aggSE  = toSymExpr(call->get(1));
+  SymExpr*  lhsSE  = toSymExpr(call->get(2));
+  SymExpr*  rhsSE  = toSymExpr(call->get(3));
+  CallExpr* retval = NULL;
+
+  INT_ASSERT(aggSE && lhsSE && rhsSE);
+
+  if (canAggregateRead(aggSE->symbol(), lhsSE->symbol(), rhsSE->symbol())) {
+    reportAggregation(call, "remote reads in forall assignment");
+
+    retval = new CallExpr("copy",
+                          gMethodToken,
+                          aggSE->remove(),
+                          lhsSE->remove(),
+                          rhsSE->remove());
+
+  } else {
+    retval = new CallExpr("=", lhsSE->remove(), rhsSE->remove());
+  }
+
+  call->replace(retval);
+
+  return retval;
+}
+
+//
+// chpl_agg.copy() moves raw bytes between locales, so both sides must be
+// references to elements of the aggregator's POD element type.  Anything
+// else, e.g. a slice on the right-hand side or a coercion, keeps '='.
+//
+static bool canAggregateRead(Symbol* agg, Symbol* lhs, Symbol* rhs) {
+  AggregateType* at     = toAggregateType(agg->getValType());
+  bool           retval = false;
+
+  if (at                                      != NULL &&
+      at->instantiatedFrom                    != NULL &&
+      at->instantiatedFrom->symbol->name      == astr("chpl__SrcAggregator") &&
+      lhs->isRef()                            == true &&
+      rhs->isRef()                            == true) {
+    Type* eltType = at->getField("elemType")->type;
+
+    propagateNotPOD(eltType);
+
+    retval = isPOD(eltType)            == true    &&
+             lhs->getValType()         == eltType &&
+             rhs->getValType()         == eltType;
+  }
+
+  return retval;
+}
+
+Expr* lowerMaybeAggregateAtomic(CallExpr* call) {
+  SymExpr*    aggSE  = toSymExpr(call->get(1));
+  const char* method = get_string(call->get(2));
+  SymExpr*    eltSE  = toSymExpr(call->get(3));
+  Expr*       value  = call->get(4);
+  CallExpr*   retval = NULL;
+
+  INT_ASSERT(aggSE && eltSE);
+
+  if (canAggregateAtomic(aggSE->symbol(), eltSE->symbol())) {
+    reportAggregation(call, "remote atomic updates in forall");
+
+    retval = new CallExpr("update",
+                          gMethodToken,
+                          aggSE->remove(),
+                          eltSE->remove(),
+                          value->remove());
+
+  } else {
+    retval = new CallExpr(method,
+                          gMethodToken,
+                          eltSE->remove(),
+                          value->remove());
+  }
+
+  call->replace(retval);
+
+  return retval;
+}
+
+//
+// chpl_agg.update() applies the update to the element through its local
+// address on the owning locale, so the element must be a reference to the
+// aggregator's atomic type.  chpl__atomicAggregatorFor() only returns a
+// chpl__AtomicAggregator for arrays of atomic integers and reals.
+//
+static bool canAggregateAtomic(Symbol* agg, Symbol* elt) {
+  AggregateType* at     = toAggregateType(agg->getValType());
+  bool           retval = false;
+
+  // The type and the op are instantiated one after the other.
+  if (at                                      != NULL &&
+      at->instantiatedFrom                    != NULL &&
+      at->getRootInstantiation()->symbol->name ==
+        astr("chpl__AtomicAggregator")        &&
+      elt->isRef()                            == true) {
+    retval = elt->getValType() == at->getField("atomicType")->type;
+  }
+
+  return retval;
+}
+
+//
+// A forall in a generic function is resolved once per instantiation;
+// report each source location only once.
+//
+static void reportAggregation(CallExpr* call, const char* what) {
+  static std::set<std::string> reported;
+
+  if (fReportAutoAggregation == true) {
+    ModuleSymbol* mod = call->getModule();
+
+    if (developer == true || mod->modTag == MOD_USER) {
+      std::string loc = std::string(call->fname()) + ":" +
+                        istr(call->linenum());
+
+      if (reported.insert(loc).second == true) {
+        printf("Aggregated %s (%s)\n", what, loc.c_str());
+      }
+    }
+  }
+}
@@ -0,0 +1,884 @@
+/*
+ * Copyright 2004-2018 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//
+// Fusion of adjacent parallel loops (--forall-fusion)
+//
+// Each whole-array statement such as
+//
+//   var T = A + alpha*B;
+//   C = T * 2;
+//   D = sqrt(C);
+//
+// is a separate promoted forall loop, and T is a temporary array that
+// nothing else uses.  Before normalization a run of such statements is
+// rewritten into
+//
+//   if __primitive("fusible", "promoted", ..., C, D, A, alpha, B) {
+//     if chpl__canFuse(C, D, A, alpha, B) {
+//       forall i in C.domain {
+//         var T = chpl__fusedElt(A, i) + chpl__fusedElt(alpha, i) * ...;
+//         C[i] = T * 2;
+//         D[i] = sqrt(chpl__fusedElt(C, i));
+//       }
+//     } else { <the original statements> }
+//   } else { <the original statements> }
+//
+// Resolution folds the primitive to 'true' when the assigned variables are
+// arrays, everything else the statements read is an array or a numeric or
+// boolean scalar, and each operator or function the original statements
+// apply to an array resolves to the promotion of a scalar function rather
+// than, say, a user overload for whole arrays.  chpl__canFuse() (modules/internal/ChapelForallFusion)
+// then checks at run time that all the arrays are declared over the same
+// domain.  Promotion zips the arrays, so every statement only combines the
+// elements at one index, and one loop over that domain computes the same
+// result with one pass over memory, one set of tasks, and no temporary
+// arrays.  The statements may only apply arithmetic operators and
+// elementwise math functions, and a temporary may not be used anywhere
+// outside of the run.
+//
+// Likewise, adjacent forall loops over the same domain or range
+//
+//   forall i in D do B[i] = A[i] + 1;
+//   forall i in D do C[i] = B[i] * 2;
+//
+// become a single forall whose body holds both bodies, guarded by
+// __primitive("fusible", "forall", ..., D).  Their bodies may only assign
+// elements indexed by the loop index and local variables, and an array
+// written by one loop may only be read by another at the loop index.
+//
+
+#include "optimizations.h"
+
+#include "astutil.h"
+#include "resolution.h"
+#include "build.h"
+#include "driver.h"
+#include "expr.h"
+#include "ForallStmt.h"
+#include "stlUtil.h"
+#include "stmt.h"
+#include "stringutil.h"
+#include "symbol.h"
+#include "type.h"
+
+#include <algorithm>
+#include <cstring>
+#include <set>
+#include <string>
+#include <vector>
+
+typedef std::set<Symbol*> SymbolSet;
+
+// Accesses of one forall body, see forallAccesses()
+struct LoopAccesses {
+  SymbolSet written;      // arrays assigned at the loop index
+  SymbolSet readAnyhow;   // variables read other than at the loop index
+};
+
+static void        fuseForallLoops();
+static bool        isFusibleForall(ForallStmt* fs);
+static Symbol*     iterandOf(ForallStmt* fs);
+static Symbol*     indexOf(ForallStmt* fs);
+static bool        forallAccesses(ForallStmt* fs, LoopAccesses& accesses);
+static bool        blockAccesses(BlockStmt*    block,
+                                 Symbol*       idx,
+                                 SymbolSet&    locals,
+                                 LoopAccesses& accesses);
+static bool        bodyExprAccesses(Expr*            expr,
+                                    Symbol*          idx,
+                                    const SymbolSet& locals,
+                                    LoopAccesses&    accesses);
+static bool        canJoin(const LoopAccesses& group,
+                           const LoopAccesses& loop);
+static void        fuseForalls(std::vector<ForallStmt*>& loops);
+
+static void        fusePromotedStatements();
+static bool        isElementwiseExpr(Expr* expr);
+static bool        isElementwiseFn(const char* name);
+static bool        isAssignment(CallExpr* call);
+static bool        isVariable(Symbol* sym);
+static Symbol*     promotedTarget(Expr* stmt);
+static VarSymbol*  promotedTemp(Expr* stmt);
+static bool        isUsedOutside(Symbol* sym, const std::set<Expr*>& stmts);
+static void        fuseStatements(std::vector<Expr*>& stmts);
+
+static const char* locationOf(BaseAST* ast);
+
+/************************************* | **************************************
+*                                                                             *
+* Pre-normalization: fuse runs of user foralls and promoted statements.       *
+*                                                                             *
+************************************** | *************************************/
+
+void forallFusion() {
+  if (fForallFusion == true) {
+    fuseForallLoops();
+
+    fusePromotedStatements();
+  }
+}
+
+//
+// The operators and functions that promotion applies elementwise.
+//
+static bool isElementwiseFn(const char* name) {
+  static const char* names[] = {
+    "+",     "-",     "*",     "/",     "**",    "%",
+    "&",     "|",     "^",     "<<",    ">>",
+    "abs",   "sqrt",  "cbrt",  "exp",   "exp2",  "expm1",
+    "log",   "log2",  "log10", "log1p",
+    "sin",   "cos",   "tan",   "asin",  "acos",  "atan",
+    "sinh",  "cosh",  "tanh",
+    "floor", "ceil",  "round", "trunc"
+  };
+
+  bool retval = false;
+
+  for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+    if (strcmp(name, names[i]) == 0) {
+      retval = true;
+    }
+  }
+
+  return retval;
+}
+
+// '=' or one of the op-assignments that promotion applies elementwise
+static bool isAssignment(CallExpr* call) {
+  static const char* names[] = { "=", "+=", "-=", "*=", "/=" };
+
+  bool retval = false;
+
+  for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+    if (call->isNamed(names[i]) == true && call->numActuals() == 2) {
+      retval = true;
+    }
+  }
+
+  return retval;
+}
+
+// A variable or formal, as opposed to a literal, a type, or a function.
+static bool isVariable(Symbol* sym) {
+  bool retval = false;
+
+  if (VarSymbol* var = toVarSymbol(sym)) {
+    retval = var->immediate                      == NULL  &&
+             var->hasFlag(FLAG_TYPE_VARIABLE)    == false;
+
+  } else if (ArgSymbol* arg = toArgSymbol(sym)) {
+    retval = arg->hasFlag(FLAG_TYPE_VARIABLE)    == false &&
+             arg->intent                         != INTENT_TYPE;
+  }
+
+  return retval;
+}
+
+static const char* locationOf(BaseAST* ast) {
+  return astr(ast->fname(), ":", istr(ast->linenum()));
+}
+
+/************************************* | **************************************
+*                                                                             *
+* Adjacent forall loops over the same domain or range.                        *
+*                                                                             *
+************************************** | *************************************/
+
+static void fuseForallLoops() {
+  std::vector<ForallStmt*> candidates;
+
+  // Fusing creates copies of the loops, which are not candidates.
+  forv_Vec(ForallStmt, fs, gForallStmts) {
+    if (isFusibleForall(fs) == true) {
+      candidates.push_back(fs);
+    }
+  }
+
+  for_vector(ForallStmt, fs, candidates) {
+    std::vector<ForallStmt*> loops;
+    LoopAccesses             group;
+
+    // Already fused into an earlier loop, or unsuitable.
+    if (fs->inTree() == false || forallAccesses(fs, group) == false) {
+      continue;
+    }
+
+    loops.push_back(fs);
+
+    while (ForallStmt* next = toForallStmt(loops.back()->next)) {
+      LoopAccesses accesses;
+
+      if (isFusibleForall(next)                 == false ||
+          iterandOf(next)                       != iterandOf(fs) ||
+          forallAccesses(next, accesses)        == false ||
+          canJoin(group, accesses)              == false) {
+        break;
+      }
+
+      group.written.insert(accesses.written.begin(),
+                           accesses.written.end());
+      group.readAnyhow.insert(accesses.readAnyhow.begin(),
+                              accesses.readAnyhow.end());
+
+      loops.push_back(next);
+    }
+
+    if (loops.size() > 1) {
+      fuseForalls(loops);
+    }
+  }
+}
+
+// A non-zippered user forall over a variable with a plain index variable
+// and no task intents.
+static bool isFusibleForall(ForallStmt* fs) {
+  return fs->inTree()                          == true      &&
+         fs->getModule()->modTag               == MOD_USER  &&
+         fs->createdFromForLoop()              == false     &&
+         fs->zippered()                        == false     &&
+         fs->shadowVariables().length          == 0         &&
+         iterandOf(fs)                         != NULL      &&
+         indexOf(fs)                           != NULL;
+}
+
+static Symbol* iterandOf(ForallStmt* fs) {
+  Symbol* retval = NULL;
+
+  if (SymExpr* se = toSymExpr(fs->iteratedExpressions().head)) {
+    if (isVariable(se->symbol()) == true) {
+      retval = se->symbol();
+    }
+  }
+
+  return retval;
+}
+
+static Symbol* indexOf(ForallStmt* fs) {
+  Symbol* retval = NULL;
+
+  if (fs->numInductionVars() == 1) {
+    DefExpr* def = toDefExpr(fs->inductionVariables().head);
+
+    if (def->sym->hasFlag(FLAG_TEMP) == false) {
+      retval = def->sym;
+    }
+  }
+
+  return retval;
+}
+
+//
+// Record the arrays the body of 'fs' writes and the variables it reads
+// other than at the loop index.  Returns false unless every statement is
+// the declaration of a local or an assignment to a local or to X[idx].
+//
+static bool forallAccesses(ForallStmt* fs, LoopAccesses& accesses) {
+  SymbolSet locals;
+
+  return blockAccesses(fs->loopBody(), indexOf(fs), locals, accesses);
+}
+
+static bool blockAccesses(BlockStmt*    block,
+                          Symbol*       idx,
+                          SymbolSet&    locals,
+                          LoopAccesses& accesses) {
+  for_alist(stmt, block->body) {
+    if (BlockStmt* inner = toBlockStmt(stmt)) {
+      if (inner->isRealBlockStmt()               == false ||
+          inner->blockInfoGet()                  != NULL  ||
+          inner->useList                         != NULL  ||
+          inner->byrefVars                       != NULL  ||
+          blockAccesses(inner, idx, locals, accesses) == false) {
+        return false;
+      }
+
+    } else if (DefExpr* def = toDefExpr(stmt)) {
+      if (isVarSymbol(def->sym)                  == false ||
+          def->exprType                          != NULL  ||
+          def->init                              == NULL  ||
+          bodyExprAccesses(def->init, idx, locals, accesses) == false) {
+        return false;
+      }
+
+      locals.insert(def->sym);
+
+    } else if (CallExpr* call = toCallExpr(stmt)) {
+      if (isAssignment(call) == false) {
+        return false;
+      }
+
+      Expr* lhs = call->get(1);
+
+      if (SymExpr* se = toSymExpr(lhs)) {
+        if (locals.count(se->symbol()) == 0) {
+          return false;
+        }
+
+      } else if (CallExpr* elt = toCallExpr(lhs)) {
+        SymExpr* base = toSymExpr(elt->baseExpr);
+        SymExpr* at   = elt->numActuals() == 1 ? toSymExpr(elt->get(1)) : NULL;
+
+        if (base                            == NULL  ||
+            isVariable(base->symbol())      == false ||
+            locals.count(base->symbol())    != 0     ||
+            at                              == NULL  ||
+            at->symbol()                    != idx) {
+          return false;
+        }
+
+        accesses.written.insert(base->symbol());
+
+      } else {
+        return false;
+      }
+
+      if (bodyExprAccesses(call->get(2), idx, locals, accesses) == false) {
+        return false;
+      }
+
+    } else {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static bool bodyExprAccesses(Expr*            expr,
+                             Symbol*          idx,
+                             const SymbolSet& locals,
+                             LoopAccesses&    accesses) {
+  bool retval = false;
+
+  if (SymExpr* se = toSymExpr(expr)) {
+    Symbol* sym = se->symbol();
+
+    if (isVariable(sym) == true) {
+      if (sym != idx && locals.count(sym) == 0) {
+        accesses.readAnyhow.insert(sym);
+      }
+
+      retval = true;
+
+    } else {
+      retval = isVarSymbol(sym) && toVarSymbol(sym)->immediate != NULL;
+    }
+
+  } else if (CallExpr* call = toCallExpr(expr)) {
+    if (call->primitive != NULL || call->partialTag == true) {
+      retval = false;
+
+    } else if (SymExpr* base = toSymExpr(call->baseExpr)) {
+      // Y[idx] is an indexed read, Y[anything else] reads Y anyhow.
+      SymExpr* at = call->numActuals() == 1 ? toSymExpr(call->get(1)) : NULL;
+
+      if (isVariable(base->symbol()) == false) {
+        retval = false;
+
+      } else if (at != NULL && at->symbol() == idx) {
+        retval = true;
+
+      } else {
+        accesses.readAnyhow.insert(base->symbol());
+        retval = true;
+
+        for_actuals(actual, call) {
+          retval = retval &&
+                   bodyExprAccesses(actual, idx, locals, accesses);
+        }
+      }
+
+    } else if (UnresolvedSymExpr* base = toUnresolvedSymExpr(call->baseExpr)) {
+      retval = isElementwiseFn(base->unresolved);
+
+      for_actuals(actual, call) {
+        retval = retval &&
+                 isNamedExpr(actual) == false &&
+                 bodyExprAccesses(actual, idx, locals, accesses);
+      }
+    }
+  }
+
+  return retval;
+}
+
+//
+// Fusing lets an iteration of one loop run before iterations of the
+// loops ahead of it.  That is only safe when no loop reads an array that
+// another one writes, except at the same index.
+//
+static bool canJoin(const LoopAccesses& group, const LoopAccesses& loop) {
+  for_set(Symbol, sym, loop.readAnyhow) {
+    if (group.written.count(sym) != 0) {
+      return false;
+    }
+  }
+
+  for_set(Symbol, sym, group.readAnyhow) {
+    if (loop.written.count(sym) != 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static void fuseForalls(std::vector<ForallStmt*>& loops) {
+  SET_LINENO(loops[0]);
+
+  ForallStmt* first    = loops[0];
+  Symbol*     idx      = indexOf(first);
+  BlockStmt*  unfused  = new BlockStmt();
+  BlockStmt*  fused    = new BlockStmt();
+  const char* msg      = astr("Fused ",
+                              istr((int) loops.size()),
+                              " forall loops (",
+                              locationOf(first),
+                              ")");
+  CallExpr*   fusible  = new CallExpr(PRIM_FUSIBLE,
+                                      new_CStringSymbol("forall"),
+                                      new_CStringSymbol(msg),
+                                      iterandOf(first));
+  CondStmt*   cond     = new CondStmt(fusible, fused, unfused);
+
+  first->insertBefore(cond);
+
+  for_vector(ForallStmt, fs, loops) {
+    unfused->insertAtTail(fs->copy());
+  }
+
+  // Each body keeps its own scope within the fused body.
+  for_vector(ForallStmt, fs, loops) {
+    BlockStmt* body = new BlockStmt();
+
+    for_alist(stmt, fs->loopBody()->body) {
+      body->insertAtTail(stmt->remove());
+    }
+
+    if (fs != first) {
+      SymbolMap map;
+
+      map.put(indexOf(fs), idx);
+      update_symbols(body, &map);
+
+      fs->remove();
+    }
+
+    first->loopBody()->insertAtTail(body);
+  }
+
+  fused->insertAtTail(first->remove());
+}
+
+/************************************* | **************************************
+*                                                                             *
+* Runs of promoted whole-array statements.                                    *
+*                                                                             *
+************************************** | *************************************/
+
+static void fusePromotedStatements() {
+  std::vector<BlockStmt*> blocks;
+
+  // Fusing creates copies of the statements, which are not candidates.
+  forv_Vec(BlockStmt, block, gBlockStmts) {
+    if (block->inTree()                  == true &&
+        block->getModule()->modTag       == MOD_USER) {
+      blocks.push_back(block);
+    }
+  }
+
+  for_vector(BlockStmt, block, blocks) {
+    Expr* stmt = block->body.head;
+
+    while (stmt != NULL) {
+      std::vector<Expr*> run;
+      std::set<Expr*>    inRun;
+
+      while (stmt != NULL &&
+             (promotedTarget(stmt) != NULL || promotedTemp(stmt) != NULL)) {
+        run.push_back(stmt);
+        inRun.insert(stmt);
+        stmt = stmt->next;
+      }
+
+      if (run.size() == 0) {
+        stmt = stmt->next;
+        continue;
+      }
+
+      // Stop the run at the first temporary that is used after it.
+      for (size_t i = 0; i < run.size(); i++) {
+        VarSymbol* temp = promotedTemp(run[i]);
+
+        if (temp != NULL && isUsedOutside(temp, inRun) == true) {
+          stmt = run[i]->next;
+          run.resize(i);
+          break;
+        }
+      }
+
+      if (run.size() > 1) {
+        fuseStatements(run);
+      }
+    }
+  }
+}
+
+// For 'X = expr' or 'X op= expr' with elementwise 'expr', X; else NULL.
+static Symbol* promotedTarget(Expr* stmt) {
+  Symbol* retval = NULL;
+
+  if (CallExpr* call = toCallExpr(stmt)) {
+    if (isAssignment(call) == true) {
+      SymExpr* lhs = toSymExpr(call->get(1));
+
+      if (lhs                             != NULL &&
+          isVariable(lhs->symbol())       == true &&
+          isElementwiseExpr(call->get(2)) == true) {
+        retval = lhs->symbol();
+      }
+    }
+  }
+
+  return retval;
+}
+
+//
+// For 'var T = expr' with elementwise 'expr' in a function, T; else NULL.
+// Module-level statements are in the module's init function by now, but
+// their variables are globals.
+//
+static VarSymbol* promotedTemp(Expr* stmt) {
+  VarSymbol* retval = NULL;
+
+  if (DefExpr* def = toDefExpr(stmt)) {
+    FnSymbol* fn = toFnSymbol(def->parentSymbol);
+
+    if (VarSymbol* var = toVarSymbol(def->sym)) {
+      if (fn                                     != NULL  &&
+          fn                                     != fn->getModule()->initFn &&
+          def->exprType                          == NULL  &&
+          def->init                              != NULL  &&
+          var->hasFlag(FLAG_CONFIG)              == false &&
+          var->hasFlag(FLAG_PARAM)               == false &&
+          var->hasFlag(FLAG_TYPE_VARIABLE)       == false &&
+          var->hasFlag(FLAG_REF_VAR)             == false &&
+          var->hasFlag(FLAG_EXTERN)              == false &&
+          var->hasFlag(FLAG_EXPORT)              == false &&
+          isElementwiseExpr(def->init)           == true) {
+        retval = var;
+      }
+    }
+  }
+
+  return retval;
+}
+
+// Literals and variables combined by elementwise operators and functions.
+static bool isElementwiseExpr(Expr* expr) {
+  bool retval = false;
+
+  if (SymExpr* se = toSymExpr(expr)) {
+    retval = isVariable(se->symbol()) == true ||
+             (isVarSymbol(se->symbol())              == true &&
+              toVarSymbol(se->symbol())->immediate   != NULL);
+
+  } else if (CallExpr* call = toCallExpr(expr)) {
+    UnresolvedSymExpr* base = toUnresolvedSymExpr(call->baseExpr);
+
+    retval = base                               != NULL  &&
+             call->partialTag                   == false &&
+             isElementwiseFn(base->unresolved)  == true;
+
+    for_actuals(actual, call) {
+      retval = retval                           == true  &&
+               isNamedExpr(actual)              == false &&
+               isElementwiseExpr(actual)        == true;
+    }
+  }
+
+  return retval;
+}
+
+static bool isUsedOutside(Symbol* sym, const std::set<Expr*>& stmts) {
+  for_SymbolSymExprs(se, sym) {
+    Expr* stmt = se->getStmtExpr();
+
+    while (stmt != NULL && stmts.count(stmt) == 0) {
+      stmt = stmt->parentExpr;
+    }
+
+    if (stmt == NULL) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+static void fuseStatements(std::vector<Expr*>& stmts) {
+  Expr*                    first  = stmts[0];
+  Symbol*                  target = NULL;
+  std::vector<Symbol*>     targets;
+  std::vector<Symbol*>     operands;
+  std::vector<const char*> temps;
+
+  for_vector(Expr, stmt, stmts) {
+    if (Symbol* sym = promotedTarget(stmt)) {
+      bool isTemp = std::find(stmts.begin(), stmts.end(), sym->defPoint) !=
+                    stmts.end();
+
+      if (isTemp == false &&
+          std::find(targets.begin(), targets.end(), sym) == targets.end()) {
+        targets.push_back(sym);
+      }
+
+    } else {
+      temps.push_back(promotedTemp(stmt)->name);
+    }
+  }
+
+  // Only temporaries are assigned; nothing to loop over.
+  if (targets.size() == 0) {
+    return;
+  }
+
+  target = targets[0];
+
+  for_vector(Expr, stmt, stmts) {
+    std::vector<SymExpr*> symExprs;
+
+    collectSymExprs(stmt, symExprs);
+
+    for_vector(SymExpr, se, symExprs) {
+      Symbol* sym = se->symbol();
+
+      if (isVariable(sym)                                        == true &&
+          sym->defPoint                                          != NULL &&
+          std::find(stmts.begin(), stmts.end(), sym->defPoint)   == stmts.end() &&
+          std::find(targets.begin(), targets.end(), sym)         == targets.end() &&
+          std::find(operands.begin(), operands.end(), sym)       == operands.end()) {
+        operands.push_back(sym);
+      }
+    }
+  }
+
+  SET_LINENO(first);
+
+  std::string msg = std::string("Fused ") + istr((int) stmts.size()) +
+                    " promoted statements into one forall";
+
+  for (size_t i = 0; i < temps.size(); i++) {
+    msg += i == 0 ? ", eliminating temporary " : ", ";
+    msg += temps[i];
+  }
+
+  msg += std::string(" (") + locationOf(first) + ")";
+
+  BlockStmt* unfused  = new BlockStmt();
+  BlockStmt* fused    = new BlockStmt();
+  CallExpr*  fusible  = new CallExpr(PRIM_FUSIBLE,
+                                     new_CStringSymbol("promoted"),
+                                     new_CStringSymbol(astr(msg.c_str())),
+                                     new_IntSymbol((int) targets.size()));
+  CallExpr*  canFuse  = new CallExpr("chpl__canFuse");
+
+  for_vector(Symbol, sym, targets) {
+    fusible->insertAtTail(sym);
+    canFuse->insertAtTail(sym);
+  }
+
+  for_vector(Symbol, sym, operands) {
+    fusible->insertAtTail(sym);
+    canFuse->insertAtTail(sym);
+  }
+
+  first->insertBefore(new CondStmt(fusible, fused, unfused));
+
+  for_vector(Expr, stmt, stmts) {
+    unfused->insertAtTail(stmt->remove());
+  }
+
+  // One copy of the statements in the loop, another if the domains differ
+  BlockStmt*  loop = ForallStmt::build(new UnresolvedSymExpr("chpl_fusedIdx"),
+                                       buildDotExpr(new SymExpr(target), "_dom"),
+                                       NULL,
+                                       unfused->copy(),
+                                       false);
+  ForallStmt* fs   = toForallStmt(loop->body.head);
+  Symbol*     idx  = indexOf(fs);
+
+  fused->insertAtTail(new CondStmt(canFuse, loop, unfused->copy()));
+
+  for_alist(stmt, fs->loopBody()->body) {
+    CallExpr*             assign = toCallExpr(stmt);
+    std::vector<SymExpr*> symExprs;
+
+    collectSymExprs(stmt, symExprs);
+
+    for_vector(SymExpr, se, symExprs) {
+      Symbol* sym = se->symbol();
+
+      if (std::find(targets.begin(),  targets.end(),  sym) == targets.end() &&
+          std::find(operands.begin(), operands.end(), sym) == operands.end()) {
+        continue;
+      }
+
+      if (assign != NULL && se == assign->get(1)) {
+        // The assigned array: X[idx]
+        se->replace(new CallExpr(new SymExpr(sym), idx));
+
+      } else {
+        se->replace(new CallExpr("chpl__fusedElt", sym, idx));
+      }
+    }
+  }
+}
+
+/************************************* | **************************************
+*                                                                             *
+* Resolution: fuse if the types allow it.                                     *
+*                                                                             *
+************************************** | *************************************/
+
+static bool isFusibleOperand(Type* type, bool arrayOnly);
+static bool isPromotedStatements(CallExpr* call);
+
+Expr* lowerFusible(CallExpr* call) {
+  const char* kind   = get_string(call->get(1));
+  const char* msg    = get_string(call->get(2));
+  bool        fuse   = true;
+
+  if (strcmp(kind, "forall") == 0) {
+    // Domain and range iterators yield each index once.
+    Type* type = call->get(3)->getValType();
+
+    fuse = type->symbol->hasFlag(FLAG_DOMAIN) == true ||
+           type->symbol->hasFlag(FLAG_RANGE)  == true;
+
+  } else {
+    VarSymbol* nTargets = toVarSymbol(toSymExpr(call->get(3))->symbol());
+    int        n        = nTargets->immediate->int_value();
+
+    // The assigned variables come first.
+    for (int i = 4; i <= call->numActuals(); i++) {
+      Type* type = call->get(i)->getValType();
+
+      fuse = fuse && isFusibleOperand(type, i < 4 + n);
+    }
+
+    fuse = fuse && isPromotedStatements(call);
+  }
+
+  if (fuse == true && fReportForallFusion == true) {
+    static std::set<std::string> reported;
+
+    ModuleSymbol* mod = call->getModule();
+
+    if ((developer == true || mod->modTag == MOD_USER) &&
+        reported.insert(msg).second == true) {
+      printf("%s\n", msg);
+    }
+  }
+
+  Expr* retval = new SymExpr(fuse ? gTrue : gFalse);
+
+  call->replace(retval);
+
+  return retval;
+}
+
+// Arrays, and for operands also numeric and boolean scalars.
+static bool isFusibleOperand(Type* type, bool arrayOnly) {
+  bool retval = type->symbol->hasFlag(FLAG_ARRAY);
+
+  if (retval == false && arrayOnly == false) {
+    retval = is_arithmetic_type(type) || is_bool_type(type);
+  }
+
+  return retval;
+}
+
+//
+// Resolve the original statements, which the primitive guards in the else
+// branch, and check that every operator or function they apply to an array
+// is a promotion wrapper.  Otherwise the fused loop, which applies it to
+// each element, would not compute what the statements do.  Assignments and
+// copies of whole arrays come from the internal modules.
+//
+static bool isPromotedStatements(CallExpr* call) {
+  Expr*      stmt    = call->getStmtExpr();
+  CondStmt*  cond    = toCondStmt(stmt);
+  BlockStmt* unfused = NULL;
+  bool       retval  = true;
+
+  // The condition may have been moved into a temporary by normalize.
+  if (cond == NULL) {
+    if (CallExpr* move = toCallExpr(stmt)) {
+      Symbol* tmp = toSymExpr(move->get(1))->symbol();
+
+      for (Expr* next = stmt->next; next != NULL; next = next->next) {
+        if (CondStmt* c = toCondStmt(next)) {
+          SymExpr* condExpr = toSymExpr(c->condExpr);
+
+          if (condExpr != NULL && condExpr->symbol() == tmp) {
+            cond = c;
+            break;
+          }
+        }
+      }
+    }
+  }
+
+  if (cond != NULL) {
+    unfused = cond->elseStmt;
+  }
+
+  if (unfused == NULL) {
+    return false;
+  }
+
+  resolveBlockStmt(unfused);
+
+  std::vector<CallExpr*> calls;
+
+  collectCallExprs(unfused, calls);
+
+  for_vector(CallExpr, fnCall, calls) {
+    if (FnSymbol* fn = fnCall->resolvedFunction()) {
+      bool hasArray = false;
+
+      for_actuals(actual, fnCall) {
+        if (actual->getValType()->symbol->hasFlag(FLAG_ARRAY) == true) {
+          hasArray = true;
+        }
+      }
+
+      if (hasArray == true && fn->hasFlag(FLAG_PROMOTION_WRAPPER) == false) {
+        if (isElementwiseFn(fn->name) == true ||
+            fn->getModule()->modTag   != MOD_INTERNAL) {
+          retval = false;
+        }
+      }
+    }
+  }
+
+  return retval;
+}
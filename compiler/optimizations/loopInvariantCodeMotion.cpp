@@ -35,6 +35,7 @@
 #include "symbol.h"
 #include "timer.h"
 #include "optimizations.h"
+#include "parallelFor.h"
 #include "WhileStmt.h"
 
 #include <algorithm>
@@ -172,6 +173,11 @@ public:
       return header;
     }
 
+    //get the loop statement, or NULL if the loop is not a LoopStmt
+    LoopStmt* getLoopAST() {
+      return loopAST;
+    }
+
     //get the actual blocks in the loop
     std::vector<BasicBlock*>* getBlocks() {
       return loopBlocks;
@@ -676,6 +682,92 @@ static bool allOperandsAreLoopInvariant(Expr* expr, std::set<SymExpr*>& loopInva
 }
 
 
+/*
+ * Check if memory of type 'outer' may hold a value of type 'inner', either
+ * because they are the same type or because 'inner' is stored by value
+ * somewhere within a record, union or tuple 'outer'. Class fields are not
+ * followed since they only hold a pointer to memory stored elsewhere.
+ */
+static bool typeMayContain(Type* outer, Type* inner) {
+  if (outer == inner) {
+    return true;
+  }
+
+  if (AggregateType* at = toAggregateType(outer)) {
+    if (at->isClass() == false) {
+      for_fields(field, at) {
+        if (field->isRef() == false && typeMayContain(field->type, inner)) {
+          return true;
+        }
+      }
+    }
+  }
+
+  return false;
+}
+
+
+/*
+ * A const formal that is passed by reference cannot be changed through its
+ * own name, but the loop might still write the memory it refers to through
+ * another reference, a formal, a field or a global. Memory of one type can
+ * only hold a value of another type if one is nested within the other, so
+ * only writes of a related type matter. Locals of the function are not
+ * considered, since they cannot be what the formal refers to. Any call is
+ * assumed to write the formal.
+ */
+static bool loopMayWriteConstFormal(ArgSymbol* arg, FnSymbol* fn,
+    std::vector<SymExpr*>& loopSymExprs, std::vector<CallExpr*>& callsInLoop,
+    symToVecSymExprMap& localDefMap) {
+
+  if (callsInLoop.size() != 0) {
+    return true;
+  }
+
+  Type* argType = arg->getValType();
+
+  for_vector(SymExpr, symExpr, loopSymExprs) {
+    if (CallExpr* call = toCallExpr(symExpr->parentExpr)) {
+      if (call->isPrimitive(PRIM_VIRTUAL_METHOD_CALL) ||
+          call->isPrimitive(PRIM_ARRAY_SET) ||
+          call->isPrimitive(PRIM_ARRAY_SET_FIRST)) {
+        return true;
+      }
+    }
+  }
+
+  symToVecSymExprMap::iterator it;
+  for (it = localDefMap.begin(); it != localDefMap.end(); it++) {
+    Symbol* sym = it->first;
+
+    if (isVarSymbol(sym) && sym->isRef() == false &&
+        sym->defPoint->parentSymbol == fn) {
+      continue;
+    }
+
+    for_vector(SymExpr, def, *it->second) {
+      // Pointing a reference somewhere else does not write any memory
+      if (sym->isRef()) {
+        if (CallExpr* call = toCallExpr(def->parentExpr)) {
+          if (call->isPrimitive(PRIM_MOVE) && isDefAndOrUse(def) == 1) {
+            continue;
+          }
+        }
+      }
+
+      Type* defType = sym->getValType();
+
+      if (typeMayContain(defType, argType) ||
+          typeMayContain(argType, defType)) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+
 /*
  * The basic algorithm will be to find all of the constants, and then find things that
  * have no definitions in the loop. We also need to consider a symbols aliases when we're
@@ -837,6 +929,7 @@ static void computeLoopInvariants(std::vector<SymExpr*>& loopInvariants,
   std::set<SymExpr*> loopInvariantOperands;
   std::set<SymExpr*> loopInvariantInstructions;
   std::map<SymExpr*, std::set<SymExpr*> > actualDefs;
+  std::map<ArgSymbol*, bool> constFormalWritten;
   for_vector(SymExpr, symExpr, loopSymExprs) {
 
     //skip already known invariants
@@ -907,6 +1000,20 @@ static void computeLoopInvariants(std::vector<SymExpr*>& loopInvariants,
     }
 
     bool mightHaveBeenDeffedElseWhere = false;
+    // A const ref formal is only changed elsewhere if the loop might write
+    // the memory it refers to. This lets loads through it, such as fetching
+    // a possibly remote class from a const ref formal, be hoisted.
+    bool unchangedConstFormal = false;
+    if (ArgSymbol* argSymbol = toArgSymbol(symExpr->symbol())) {
+      if (argSymbol->isRef() && argSymbol->isConstant()) {
+        if (constFormalWritten.count(argSymbol) == 0) {
+          constFormalWritten[argSymbol] =
+            loopMayWriteConstFormal(argSymbol, fn, loopSymExprs, callsInLoop,
+                                    localDefMap);
+        }
+        unchangedConstFormal = constFormalWritten[argSymbol] == false;
+      }
+    }
     // assume that anything passed in by ref has been changed elsewhere
     // Note that not all things that are passed by ref will have the ref intent
     // flag, and may just be ref variables. This is a known bug, see comments
@@ -914,7 +1021,7 @@ static void computeLoopInvariants(std::vector<SymExpr*>& loopInvariants,
     if (isArgSymbol(symExpr->symbol()) &&
         symExpr->getValType()->symbol->hasFlag(FLAG_ITERATOR_CLASS) == false) {
       if(ArgSymbol* argSymbol = toArgSymbol(symExpr->symbol())) {
-        if(argSymbol->isRef()) {
+        if(argSymbol->isRef() && !unchangedConstFormal) {
           mightHaveBeenDeffedElseWhere = true;
         }
       }
@@ -943,7 +1050,7 @@ static void computeLoopInvariants(std::vector<SymExpr*>& loopInvariants,
         mightHaveBeenDeffedElseWhere = true;
       }
     }
-    if (symExpr->symbol()->isRef()) {
+    if (symExpr->symbol()->isRef() && !unchangedConstFormal) {
         mightHaveBeenDeffedElseWhere = true;
     }
     for_set(Symbol, aliasSym, aliases[symExpr->symbol()]) {
@@ -1153,23 +1260,304 @@ static bool canPerformCodeMotion(Loop* loop) {
 
 
 /*
- * The basic algorithm for loop invariant code motion is as follows:
- * First figure out where the loops actually are. To do this the dominators need
- * to be computed and then the natural loops can be collected.
+ * Scalar promotion of class fields that are updated in a loop.
  *
- * Now that you have identified the loops you can compute the invariants. A definition
- * is invariant if the operations are loop and invariant and all the operands are loop
- * invariant. An operand is loop invariant if it is constant, has no definitions that
- * reach it located inside of the loop, or it has one definition that reaches it, that
- * definition is in the loop, and that definition is itself loop invariant.
+ * A loop such as
  *
- * You now have a list of all the definitions that are loop invariant, these can be
- * hoisted before the loop(into a preheader of sorts) so long as they definition dominates
- * all uses in the loop, and the block that the definition is located in dominates all exits.
+ *   for i in 1..n do c.total += i;
+ *
+ * binds a reference to c.total and updates the field through it in every
+ * iteration, which is a GET and a PUT per iteration when c is remote. When
+ * the loop only accesses the field through such references, the field is
+ * loaded into a local the first time the loop binds a reference to it, the
+ * references are bound to the local instead, and the local is stored back
+ * to the field once after the loop. A loop that never binds a reference
+ * does not access the field at all, as before.
+ *
+ * The loop may not contain calls, which rules out on statements and tasks
+ * that could access the field, nor synchronization variables (see
+ * canPerformCodeMotion()), nor jumps out of the loop, so that the loop is
+ * always left through the statement that follows it.
  */
-// This function returns the number of loops LICM'd
-static long licmFn(FnSymbol* fn) {
-  long numLoops = 0;
+typedef std::pair<Symbol*, Symbol*> BaseAndField;
+
+static bool isScalarType(Type* type) {
+  return is_bool_type(type) || is_int_type(type) || is_uint_type(type) ||
+         is_real_type(type) || is_imag_type(type) || is_complex_type(type);
+}
+
+/*
+ * Check if 'call' binds a reference local to 'fn' to a scalar field of a
+ * class that is not changed in the loop.
+ */
+static bool isFieldBinding(CallExpr* call, FnSymbol* fn, LoopStmt* loopAST) {
+  if (call->isPrimitive(PRIM_MOVE) == false) {
+    return false;
+  }
+
+  SymExpr*  lhs = toSymExpr(call->get(1));
+  CallExpr* rhs = toCallExpr(call->get(2));
+
+  if (lhs == NULL || rhs == NULL || rhs->isPrimitive(PRIM_GET_MEMBER) == false) {
+    return false;
+  }
+
+  Symbol* ref   = lhs->symbol();
+  Symbol* base  = toSymExpr(rhs->get(1))->symbol();
+  Symbol* field = toSymExpr(rhs->get(2))->symbol();
+
+  if (isVarSymbol(ref) == false || ref->isRef() == false ||
+      ref->defPoint->parentSymbol != fn) {
+    return false;
+  }
+
+  if (isScalarType(field->type) == false || isClass(base->type) == false ||
+      base->isRef() == true || isLcnSymbol(base) == false ||
+      loopAST->contains(base->defPoint) == true) {
+    return false;
+  }
+
+  for_SymbolSymExprs(se, base) {
+    if (loopAST->contains(se) && (isDefAndOrUse(se) & 1)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/*
+ * Check if 'ref' is only ever bound to the address of a local of 'fn' or to
+ * a field other than 'field', and so cannot refer to 'field'. Only a local
+ * reference of 'fn' has all of its bindings in view; a ref formal or a ref
+ * global may refer to anything, including 'field'.
+ */
+static bool cannotReferToField(Symbol* ref, Symbol* field, FnSymbol* fn) {
+  bool sawBinding = false;
+
+  if (isVarSymbol(ref) == false || ref->defPoint->parentSymbol != fn) {
+    return false;
+  }
+
+  for_SymbolSymExprs(se, ref) {
+    CallExpr* call = toCallExpr(se->parentExpr);
+
+    if (call && call->isPrimitive(PRIM_MOVE) && call->get(1) == se) {
+      CallExpr* rhs = toCallExpr(call->get(2));
+
+      sawBinding = true;
+
+      if (rhs == NULL) {
+        return false;
+
+      } else if (rhs->isPrimitive(PRIM_GET_MEMBER)) {
+        if (toSymExpr(rhs->get(2))->symbol() == field) {
+          return false;
+        }
+
+      } else if (rhs->isPrimitive(PRIM_ADDR_OF) ||
+                 rhs->isPrimitive(PRIM_SET_REFERENCE)) {
+        Symbol* sym = toSymExpr(rhs->get(1))->symbol();
+
+        if (isVarSymbol(sym) == false || sym->isRef() == true ||
+            sym->defPoint->parentSymbol != fn) {
+          return false;
+        }
+
+      } else {
+        return false;
+      }
+    }
+  }
+
+  return sawBinding;
+}
+
+/*
+ * Check if 'use' of a reference reads or updates the referenced value,
+ * without creating another reference to it.
+ */
+static bool isValueAccess(SymExpr* use) {
+  if (CallExpr* call = toCallExpr(use->parentExpr)) {
+    if (call->get(1) == use &&
+        (call->isPrimitive(PRIM_ASSIGN) || isOpEqualPrim(call))) {
+      return true;
+    }
+
+    if (call->isPrimitive(PRIM_DEREF)) {
+      return true;
+    }
+
+    if (call->isPrimitive(PRIM_MOVE) && call->get(2) == use) {
+      return toSymExpr(call->get(1))->symbol()->isRef() == false;
+    }
+  }
+
+  return false;
+}
+
+static bool canPromoteField(Symbol* field, FnSymbol* fn, LoopStmt* loopAST,
+                            std::vector<CallExpr*>& bindings) {
+  std::set<CallExpr*> bindingSet(bindings.begin(), bindings.end());
+  std::set<Symbol*>   refs;
+
+  for_vector(CallExpr, binding, bindings) {
+    refs.insert(toSymExpr(binding->get(1))->symbol());
+  }
+
+  // The field may only be accessed through the bindings in the loop
+  for_SymbolSymExprs(se, field) {
+    if (loopAST->contains(se)) {
+      CallExpr* binding = toCallExpr(se->parentExpr->parentExpr);
+
+      if (binding == NULL || bindingSet.count(binding) == 0) {
+        return false;
+      }
+    }
+  }
+
+  // and the references bound to it may only access the value in the loop
+  for_set(Symbol, ref, refs) {
+    for_SymbolSymExprs(se, ref) {
+      CallExpr* call = toCallExpr(se->parentExpr);
+
+      if (bindingSet.count(call) == 1 && call->get(1) == se) {
+        continue;
+      }
+
+      if (loopAST->contains(se) == false || isValueAccess(se) == false) {
+        return false;
+      }
+    }
+  }
+
+  // Nothing else in the loop may access memory that could be the field
+  std::vector<SymExpr*> symExprs;
+  collectSymExprs(loopAST, symExprs);
+
+  for_vector(SymExpr, se, symExprs) {
+    Symbol* sym = se->symbol();
+
+    if (CallExpr* call = toCallExpr(se->parentExpr)) {
+      if ((call->isPrimitive(PRIM_ARRAY_GET)       ||
+           call->isPrimitive(PRIM_ARRAY_GET_VALUE) ||
+           call->isPrimitive(PRIM_ARRAY_SET)       ||
+           call->isPrimitive(PRIM_ARRAY_SET_FIRST)) &&
+          call->get(1) == se &&
+          sym->getValType()->symbol->hasFlag(FLAG_C_PTR_CLASS)) {
+        return false;
+      }
+    }
+
+    if (sym->isRef() && refs.count(sym) == 0 &&
+        typeMayContain(sym->getValType(), field->type) &&
+        cannotReferToField(sym, field, fn) == false) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static void promoteField(Symbol* base, Symbol* field, LoopStmt* loopAST,
+                         std::vector<CallExpr*>& bindings) {
+  SET_LINENO(loopAST);
+
+  VarSymbol* local  = newTemp(astr("promoted_", field->name), field->type);
+  VarSymbol* loaded = newTemp("promoted_loaded", dtBool);
+  BlockStmt* store  = new BlockStmt();
+
+  loopAST->insertBefore(new DefExpr(local));
+  loopAST->insertBefore(new DefExpr(loaded));
+  loopAST->insertBefore(new CallExpr(PRIM_MOVE, loaded, gFalse));
+
+  for_vector(CallExpr, binding, bindings) {
+    SET_LINENO(binding);
+
+    BlockStmt* load = new BlockStmt();
+
+    load->insertAtTail(new CallExpr(PRIM_MOVE, local,
+                         new CallExpr(PRIM_GET_MEMBER_VALUE, base, field)));
+    load->insertAtTail(new CallExpr(PRIM_MOVE, loaded, gTrue));
+
+    binding->insertBefore(new CondStmt(new SymExpr(loaded),
+                                       new BlockStmt(),
+                                       load));
+    binding->get(2)->replace(new CallExpr(PRIM_ADDR_OF, local));
+  }
+
+  store->insertAtTail(new CallExpr(PRIM_SET_MEMBER, base, field, local));
+  loopAST->insertAfter(new CondStmt(new SymExpr(loaded), store));
+}
+
+static void promoteFieldUpdates(Loop* loop, FnSymbol* fn) {
+  LoopStmt* loopAST = loop->getLoopAST();
+
+  if (loopAST == NULL) {
+    return;
+  }
+
+  std::vector<GotoStmt*> gotoStmts;
+  collectGotoStmts(loopAST, gotoStmts);
+
+  for_vector(GotoStmt, gotoStmt, gotoStmts) {
+    LabelSymbol* label = gotoStmt->gotoTarget();
+
+    if (label == NULL || loopAST->contains(label->defPoint) == false) {
+      return;
+    }
+  }
+
+  std::vector<CallExpr*> calls;
+  collectCallExprs(loopAST, calls);
+
+  std::vector<BaseAndField>                        fields;
+  std::map<BaseAndField, std::vector<CallExpr*> > bindings;
+
+  for_vector(CallExpr, call, calls) {
+    if (call->isResolved() || call->isPrimitive(PRIM_VIRTUAL_METHOD_CALL)) {
+      return;
+    }
+
+    if (isFieldBinding(call, fn, loopAST)) {
+      CallExpr* rhs   = toCallExpr(call->get(2));
+      Symbol*   base  = toSymExpr(rhs->get(1))->symbol();
+      Symbol*   field = toSymExpr(rhs->get(2))->symbol();
+
+      BaseAndField key(base, field);
+
+      if (bindings.count(key) == 0) {
+        fields.push_back(key);
+      }
+
+      bindings[key].push_back(call);
+    }
+  }
+
+  for (size_t i = 0; i < fields.size(); i++) {
+    Symbol* base  = fields[i].first;
+    Symbol* field = fields[i].second;
+
+    if (canPromoteField(field, fn, loopAST, bindings[fields[i]])) {
+      promoteField(base, field, loopAST, bindings[fields[i]]);
+    }
+  }
+}
+
+
+//
+// The part of LICM that only reads the AST: the basic blocks, dominators and
+// natural loops of a function, and which of those loops have nothing that
+// prevents code motion.  Functions are analyzed in parallel (see
+// parallelFor.h); the hoisting itself runs serially in gFnSymbols order.
+//
+struct LicmFnInfo {
+  std::vector<BitVec*> dominators;
+  std::vector<Loop*>   loops;
+  std::vector<bool>    canMove;
+};
+
+static void analyzeLicmFn(FnSymbol* fn, LicmFnInfo& info) {
   //build the basic blocks, where the first bb is the entry block
   startTimer(buildBBTimer);
 
@@ -1185,28 +1573,103 @@ static long licmFn(FnSymbol* fn) {
 
   //compute the dominators
   startTimer(computeDominatorTimer);
-  std::vector<BitVec*> dominators;
   for(unsigned i = 0; i < nBlocks; i++) {
-    dominators.push_back(new BitVec(nBlocks));
+    info.dominators.push_back(new BitVec(nBlocks));
   }
-  computeDominators(dominators, basicBlocks);
+  computeDominators(info.dominators, basicBlocks);
   stopTimer(computeDominatorTimer);
 
   //Collect all of the loops
   startTimer(collectNaturalLoopsTimer);
-  std::vector<Loop*> loops;
-  collectNaturalLoops(loops, basicBlocks, entryBlock, dominators);
+  collectNaturalLoops(info.loops, basicBlocks, entryBlock, info.dominators);
   stopTimer(collectNaturalLoopsTimer);
 
+  //check that each loop doesn't have anything that
+  //would prevent code motion from occurring
+  startTimer(canPerformCodeMotionTimer);
+  for_vector(Loop, curLoop, info.loops) {
+    info.canMove.push_back(canPerformCodeMotion(curLoop));
+  }
+  stopTimer(canPerformCodeMotionTimer);
+}
+
+static void freeLicmFnInfo(LicmFnInfo& info) {
+  for_vector(Loop, loop, info.loops) {
+    delete loop;
+    loop = 0;
+  }
+
+  for_vector(BitVec, bitVec, info.dominators) {
+    delete bitVec;
+    bitVec = 0;
+  }
+
+  info.loops.clear();
+  info.dominators.clear();
+  info.canMove.clear();
+}
+
+//
+// A summary of the analysis that does not depend on where the basic blocks
+// live in memory, used to check that a parallel analysis matches a serial
+// one.
+//
+static std::vector<int> licmFnInfoSummary(LicmFnInfo& info) {
+  std::vector<int> summary;
+
+  summary.push_back(info.dominators.size());
+
+  for (size_t i = 0; i < info.loops.size(); i++) {
+    Loop* loop = info.loops[i];
+
+    summary.push_back(loop->getHeader()->id);
+    summary.push_back(info.canMove[i]);
+    summary.push_back(loop->size());
+
+    for_vector(BasicBlock, block, *loop->getBlocks()) {
+      summary.push_back(block->id);
+    }
+  }
+
+  return summary;
+}
+
+// The number of functions analyzed in parallel before hoisting from them.
+static const size_t licmBatchSize = 256;
+
+struct LicmAnalysis {
+  std::vector<FnSymbol*>   fns;
+  std::vector<LicmFnInfo>  infos;
+};
+
+static void analyzeLicmFnTask(int i, void* arg) {
+  LicmAnalysis* analysis = (LicmAnalysis*) arg;
+
+  analyzeLicmFn(analysis->fns[i], analysis->infos[i]);
+}
+
+/*
+ * The basic algorithm for loop invariant code motion is as follows:
+ * First figure out where the loops actually are. To do this the dominators need
+ * to be computed and then the natural loops can be collected.
+ *
+ * Now that you have identified the loops you can compute the invariants. A definition
+ * is invariant if the operations are loop and invariant and all the operands are loop
+ * invariant. An operand is loop invariant if it is constant, has no definitions that
+ * reach it located inside of the loop, or it has one definition that reaches it, that
+ * definition is in the loop, and that definition is itself loop invariant.
+ *
+ * You now have a list of all the definitions that are loop invariant, these can be
+ * hoisted before the loop(into a preheader of sorts) so long as they definition dominates
+ * all uses in the loop, and the block that the definition is located in dominates all exits.
+ */
+// This function returns the number of loops LICM'd
+static long licmFn(FnSymbol* fn, LicmFnInfo& info) {
   //For each loop found
-  for_vector(Loop, curLoop, loops) {
-
-    //check that this loop doesn't have anything that
-    //would prevent code motion from occurring
-    startTimer(canPerformCodeMotionTimer);
-    bool performCodeMotion = canPerformCodeMotion(curLoop);
-    stopTimer(canPerformCodeMotionTimer);
-    if(performCodeMotion == false) {
+  for (size_t i = 0; i < info.loops.size(); i++) {
+    Loop* curLoop = info.loops[i];
+
+    if(info.canMove[i] == false) {
       continue;
     }
 
@@ -1228,8 +1691,8 @@ static long licmFn(FnSymbol* fn) {
     //For each invariant, only move it if its def, dominates all uses and all exits
     for_vector(SymExpr, symExpr, loopInvariants) {
       if(CallExpr* call = toCallExpr(symExpr->parentExpr)) {
-        if(defDominatesAllUses(curLoop, symExpr, dominators, localMap, localUseMap)) {
-          if(defDominatesAllExits(curLoop, symExpr, dominators, localMap)) {
+        if(defDominatesAllUses(curLoop, symExpr, info.dominators, localMap, localUseMap)) {
+          if(defDominatesAllExits(curLoop, symExpr, info.dominators, localMap)) {
             if(defsInLoop.count(symExpr->symbol()) == 1) {
               curLoop->insertBefore(symExpr->symbol()->defPoint);
             }
@@ -1241,19 +1704,16 @@ static long licmFn(FnSymbol* fn) {
 
     freeLocalDefUseMaps(localDefMap, localUseMap);
   }
-  numLoops += loops.size();
-
-  for_vector(Loop, loop, loops) {
-    delete loop;
-    loop = 0;
-  }
 
-  for_vector(BitVec, bitVec, dominators) {
-    delete bitVec;
-    bitVec = 0;
+  //Now that the invariant bases of field accesses have been hoisted,
+  //promote fields updated in a loop to locals
+  for (size_t i = 0; i < info.loops.size(); i++) {
+    if(info.canMove[i]) {
+      promoteFieldUpdates(info.loops[i], fn);
+    }
   }
 
-  return numLoops;
+  return info.loops.size();
 }
 
 void loopInvariantCodeMotion(void) {
@@ -1268,9 +1728,46 @@ void loopInvariantCodeMotion(void) {
   startTimer(overallTimer);
   long numLoops = 0;
 
-  //TODO use stl routine here
+  std::vector<FnSymbol*> fns;
+
   forv_Vec(FnSymbol, fn, gFnSymbols) {
-    numLoops += licmFn(fn);
+    fns.push_back(fn);
+  }
+
+  // Hoisting only moves statements within a function, so none of it can
+  // change the analysis of another function, or which loops of the same
+  // function may be hoisted from.  Analyze a batch of functions in
+  // parallel, then hoist from them in order.  Batching bounds the number
+  // of functions whose basic blocks and loops are alive at once, and its
+  // size does not depend on the thread count.
+  for (size_t first = 0; first < fns.size(); first += licmBatchSize) {
+    size_t       last = std::min(first + licmBatchSize, fns.size());
+    LicmAnalysis analysis;
+
+    analysis.fns.assign(fns.begin() + first, fns.begin() + last);
+    analysis.infos.resize(analysis.fns.size());
+
+    parallelFor(analysis.fns.size(), analyzeLicmFnTask, &analysis);
+
+    for (size_t i = 0; i < analysis.fns.size(); i++) {
+      FnSymbol*   fn   = analysis.fns[i];
+      LicmFnInfo& info = analysis.infos[i];
+
+      // Check that the parallel analysis is what a serial one would
+      // produce.
+      if (fVerify && compilerThreads() > 1) {
+        std::vector<int> parallelSummary = licmFnInfoSummary(info);
+
+        freeLicmFnInfo(info);
+        analyzeLicmFn(fn, info);
+
+        INT_ASSERT(licmFnInfoSummary(info) == parallelSummary);
+      }
+
+      numLoops += licmFn(fn, info);
+
+      freeLicmFnInfo(info);
+    }
   }
 
   stopTimer(overallTimer);
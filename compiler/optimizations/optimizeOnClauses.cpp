@@ -251,6 +251,9 @@ classifyPrimitive(CallExpr *call) {
     return NOT_FAST_NOT_LOCAL;
 
   case PRIM_REDUCE_ASSIGN:
+  case PRIM_MAYBE_AGGREGATE_ASSIGN:
+  case PRIM_MAYBE_AGGREGATE_ATOMIC:
+  case PRIM_FUSIBLE:
   case PRIM_NEW:
 
   case PRIM_INIT:
@@ -37,6 +37,8 @@ static void updateTaskFunctions(Map<Symbol*, Vec<SymExpr*>*>& defMap,
 
 static void buildSyncAccessFunctionSet(Vec<FnSymbol*>& syncAccessFunctionSet);
 
+static void buildAtomicAccessFunctionSet(Vec<FnSymbol*>& atomicAccessFunctionSet);
+
 static bool isSafeToDeref(Map<Symbol*, Vec<SymExpr*>*>& defMap,
                           Map<Symbol*, Vec<SymExpr*>*>& useMap,
                           Symbol*                       field,
@@ -208,6 +210,15 @@ static void defaultForwarding(Map<Symbol*, Vec<SymExpr*>*>& useMap,
 static void insertSerialization(FnSymbol*  fn,
                                 ArgSymbol* arg);
 
+static bool canForwardSmallValue(Map<Symbol*, Vec<SymExpr*>*>& defMap,
+                                 Map<Symbol*, Vec<SymExpr*>*>& useMap,
+                                 Vec<FnSymbol*>&               syncFns,
+                                 Vec<FnSymbol*>&               atomicFns,
+                                 FnSymbol*                     fn,
+                                 ArgSymbol*                    arg);
+
+static void reportForwarding(FnSymbol* fn, ArgSymbol* arg);
+
 
 static bool shouldSerialize(ArgSymbol* arg) {
   bool retval = false;
@@ -237,8 +248,10 @@ static bool shouldSerialize(ArgSymbol* arg) {
 static void updateTaskFunctions(Map<Symbol*, Vec<SymExpr*>*>& defMap,
                                 Map<Symbol*, Vec<SymExpr*>*>& useMap) {
   Vec<FnSymbol*> syncSet;
+  Vec<FnSymbol*> atomicSet;
 
   buildSyncAccessFunctionSet(syncSet);
+  buildAtomicAccessFunctionSet(atomicSet);
 
   forv_Vec(FnSymbol, fn, gFnSymbols) {
     if (fn->hasFlag(FLAG_ON) == true) {
@@ -248,11 +261,19 @@ static void updateTaskFunctions(Map<Symbol*, Vec<SymExpr*>*>& defMap,
       // For each reference arg that is safe to dereference
       for_formals(arg, fn) {
         if (canForwardValue(defMap, useMap, syncSet, fn, arg)) {
+          reportForwarding(fn, arg);
+
           if (shouldSerialize(arg)) {
             insertSerialization(fn, arg);
           } else {
             defaultForwarding(useMap, fn, arg);
           }
+
+        } else if (canForwardSmallValue(defMap, useMap,
+                                        syncSet, atomicSet, fn, arg)) {
+          reportForwarding(fn, arg);
+
+          defaultForwarding(useMap, fn, arg);
         }
       }
     }
@@ -328,6 +349,256 @@ static bool canForwardValue(Map<Symbol*, Vec<SymExpr*>*>& defMap,
   return retval;
 }
 
+/************************************* | **************************************
+*                                                                             *
+* Forward small records and tuples of plain old data that are read through a  *
+* const ref formal, even when the variable is modified elsewhere.             *
+*                                                                             *
+* The task that runs an 'on' statement waits for the on body to complete, as  *
+* does the task that runs a 'coforall' or 'cobegin' of on statements.  So the *
+* variable can only change while the on body runs if                          *
+*                                                                             *
+*   - the on body modifies it through another formal, or                      *
+*   - another task modifies it, which is a race unless the on body            *
+*     synchronizes with that task through a sync, single or atomic variable.  *
+*                                                                             *
+* The value is copied into the on statement's argument bundle, instead of     *
+* being read through a wide reference by the remote task.                     *
+*                                                                             *
+************************************** | *************************************/
+
+static int valueWords(Type* type);
+
+static Symbol* referencedVariable(Map<Symbol*, Vec<SymExpr*>*>& defMap,
+                                  Symbol*                       sym,
+                                  int                           depth,
+                                  bool&                         known);
+
+static bool canForwardSmallValue(Map<Symbol*, Vec<SymExpr*>*>& defMap,
+                                 Map<Symbol*, Vec<SymExpr*>*>& useMap,
+                                 Vec<FnSymbol*>&               syncFns,
+                                 Vec<FnSymbol*>&               atomicFns,
+                                 FnSymbol*                     fn,
+                                 ArgSymbol*                    arg) {
+  int  words  = 0;
+  bool retval = true;
+
+  // Resolution has checked that the on body does not modify the variable
+  // through a const ref formal.
+  if (arg->hasFlag(FLAG_NO_RVF) == true  ||
+      arg->isRef()              == false ||
+      arg->intent               != INTENT_CONST_REF) {
+    retval = false;
+
+  // A begin+on does not wait for the on body.
+  } else if (fn->hasFlag(FLAG_NON_BLOCKING) == true &&
+             fn->hasFlag(FLAG_BEGIN)        == true) {
+    retval = false;
+
+  } else if (syncFns.set_in(fn) != NULL || atomicFns.set_in(fn) != NULL) {
+    retval = false;
+
+  } else {
+    DotInfo* info = dotLocaleMap[arg];
+
+    words = valueWords(arg->getValType());
+
+    if (info != NULL && info->usesDotLocale == true) {
+      retval = false;
+
+    } else if (words <= 0 || words > rvf_value_limit) {
+      retval = false;
+    }
+  }
+
+  // Each actual must refer to a local variable that no other formal refers
+  // to, unless the on body cannot modify it through that formal.
+  if (retval == true) {
+    forv_Vec(CallExpr, call, *fn->calledBy) {
+      SymExpr* actual = toSymExpr(formal_to_actual(call, arg));
+      bool     known  = false;
+      Symbol*  var    = NULL;
+
+      if (actual != NULL) {
+        var = referencedVariable(defMap, actual->symbol(), 0, known);
+      }
+
+      if (var == NULL) {
+        retval = false;
+        break;
+      }
+
+      for_formals(formal, fn) {
+        if (formal                               != arg  &&
+            formal->isRef()                      == true &&
+            (formal->intent & INTENT_FLAG_CONST) == 0) {
+          SymExpr* other = toSymExpr(formal_to_actual(call, formal));
+          Symbol*  alias = NULL;
+
+          known = false;
+
+          if (other != NULL) {
+            alias = referencedVariable(defMap, other->symbol(), 0, known);
+          }
+
+          if (known == false || alias == var) {
+            retval = false;
+            break;
+          }
+        }
+      }
+
+      if (retval == false) {
+        break;
+      }
+    }
+  }
+
+  return retval;
+}
+
+//
+// The number of scalar values in a record or tuple of plain old data, or 0
+// if 'type' is not one.  Class references count as scalars; only the
+// reference is copied.
+//
+static int valueWords(Type* type) {
+  int retval = 0;
+
+  if (isPrimitiveScalar(type) == true || isEnumType(type) == true) {
+    retval = 1;
+
+  } else if (type == dtComplex[COMPLEX_SIZE_64] ||
+             type == dtComplex[COMPLEX_SIZE_128]) {
+    retval = 2;
+
+  } else if (isClass(type) == true) {
+    retval = 1;
+
+  } else if (AggregateType* at = toAggregateType(type)) {
+    if (isRecord(at)                      == true  &&
+        isRecordWrappedType(at)           == false &&
+        isSyncType(at)                    == false &&
+        isSingleType(at)                  == false &&
+        isAtomicType(at)                  == false &&
+        at->symbol->hasFlag(FLAG_EXTERN)  == false &&
+        isPOD(at)                         == true) {
+      for_fields(field, at) {
+        int fieldWords = valueWords(field->type);
+
+        if (fieldWords == 0) {
+          retval = 0;
+          break;
+        }
+
+        retval += fieldWords;
+      }
+    }
+  }
+
+  return retval;
+}
+
+//
+// The variable that 'sym' refers to, where 'sym' is an actual of a call to
+// an on function.  That is a local variable of the calling function, or of
+// the function that calls a 'coforall' or 'cobegin' task function that
+// passes it on.  A reference to a field of a local record or tuple refers
+// to the whole variable.
+//
+// Returns NULL if 'sym' refers to a global, to a field of a class instance,
+// or to something that cannot be determined.  'known' is set to false only
+// in the last case.
+//
+static Symbol* referencedVariable(Map<Symbol*, Vec<SymExpr*>*>& defMap,
+                                  Symbol*                       sym,
+                                  int                           depth,
+                                  bool&                         known) {
+  Symbol* retval = NULL;
+
+  known = true;
+
+  if (isGlobal(sym) == true) {
+    retval = NULL;
+
+  } else if (sym->isRef() == false) {
+    retval = sym;
+
+  } else if (depth > 8) {
+    known = false;
+
+  } else if (ArgSymbol* arg = toArgSymbol(sym)) {
+    FnSymbol* fn = arg->getFunction();
+
+    known = false;
+
+    if ((arg->intent & INTENT_FLAG_CONST)     != 0    &&
+        fn->hasFlag(FLAG_COBEGIN_OR_COFORALL) == true &&
+        fn->calledBy                          != NULL &&
+        fn->calledBy->n                       == 1) {
+      CallExpr* call   = fn->calledBy->v[0];
+      SymExpr*  actual = toSymExpr(formal_to_actual(call, arg));
+
+      if (actual != NULL) {
+        retval = referencedVariable(defMap, actual->symbol(), depth + 1, known);
+      }
+    }
+
+  } else {
+    Vec<SymExpr*>* defs = defMap.get(sym);
+    CallExpr*      move = NULL;
+
+    known = false;
+
+    if (defs != NULL && defs->n == 1) {
+      move = toCallExpr(defs->v[0]->parentExpr);
+    }
+
+    if (move != NULL && move->isPrimitive(PRIM_MOVE) == true) {
+      Expr* rhs = move->get(2);
+
+      if (SymExpr* se = toSymExpr(rhs)) {
+        retval = referencedVariable(defMap, se->symbol(), depth + 1, known);
+
+      } else if (CallExpr* call = toCallExpr(rhs)) {
+        if (call->isPrimitive(PRIM_ADDR_OF)         == true ||
+            call->isPrimitive(PRIM_SET_REFERENCE)   == true ||
+            call->isPrimitive(PRIM_GET_MEMBER)      == true ||
+            call->isPrimitive(PRIM_GET_SVEC_MEMBER) == true) {
+          SymExpr* base = toSymExpr(call->get(1));
+
+          if (base == NULL) {
+            known = false;
+
+          // Fields of class instances live on the heap.
+          } else if (isClass(base->getValType()) == true) {
+            known = true;
+
+          } else {
+            retval = referencedVariable(defMap, base->symbol(), depth + 1,
+                                        known);
+          }
+        }
+      }
+    }
+  }
+
+  return retval;
+}
+
+static void reportForwarding(FnSymbol* fn, ArgSymbol* arg) {
+  if (fReportRemoteValueForwarding == true) {
+    ModuleSymbol* mod = fn->getModule();
+
+    if (developer == true || mod->modTag == MOD_USER) {
+      printf("Forwarded %s by value to on clause (%s:%d)\n",
+             arg->name,
+             fn->fname(),
+             fn->linenum());
+    }
+  }
+}
+
 static bool isSufficientlyConst(ArgSymbol* arg) {
   bool  retval     = false;
 
@@ -721,6 +992,9 @@ static bool isSyncSingleMethod(FnSymbol* fn) {
 *                                                                             *
 ************************************** | *************************************/
 
+static void addCallers(Vec<FnSymbol*>& accessFunctionSet,
+                       Vec<FnSymbol*>& accessFunctionVec);
+
 static void buildSyncAccessFunctionSet(Vec<FnSymbol*>& syncAccessFunctionSet) {
   Vec<FnSymbol*> syncAccessFunctionVec;
 
@@ -743,22 +1017,47 @@ static void buildSyncAccessFunctionSet(Vec<FnSymbol*>& syncAccessFunctionSet) {
     }
   }
 
-  //
-  // Find all functions that indirectly call methods on sync/single vars. Note
-  // that syncAccessFunctionSet is just used for fast membership check, while
-  // syncAccessFunctionVec is trickily appended to while iterating over it so
-  // that we look at callsites of newly discovered functions.
-  //
-  forv_Vec(FnSymbol, fn, syncAccessFunctionVec) {
+  addCallers(syncAccessFunctionSet, syncAccessFunctionVec);
+}
+
+//
+// Likewise for atomic variables.  Only forwarding that relies on the on body
+// not synchronizing with other tasks needs these.
+//
+static void buildAtomicAccessFunctionSet(Vec<FnSymbol*>& atomicAccessFunctionSet) {
+  Vec<FnSymbol*> atomicAccessFunctionVec;
+
+  forv_Vec(FnSymbol, fn, gFnSymbols) {
+    if (fn->_this != NULL && isAtomicType(fn->_this->getValType())) {
+      if (!fn->hasFlag(FLAG_DONT_DISABLE_REMOTE_VALUE_FORWARDING) &&
+          !atomicAccessFunctionSet.set_in(fn)) {
+        atomicAccessFunctionSet.set_add(fn);
+        atomicAccessFunctionVec.add(fn);
+      }
+    }
+  }
+
+  addCallers(atomicAccessFunctionSet, atomicAccessFunctionVec);
+}
+
+//
+// Find all functions that indirectly call functions in the set. Note that
+// accessFunctionSet is just used for fast membership check, while
+// accessFunctionVec is trickily appended to while iterating over it so
+// that we look at callsites of newly discovered functions.
+//
+static void addCallers(Vec<FnSymbol*>& accessFunctionSet,
+                       Vec<FnSymbol*>& accessFunctionVec) {
+  forv_Vec(FnSymbol, fn, accessFunctionVec) {
     forv_Vec(CallExpr, caller, *fn->calledBy) {
       FnSymbol* parent = toFnSymbol(caller->parentSymbol);
       INT_ASSERT(parent);
 
       if (!parent->hasFlag(FLAG_DONT_DISABLE_REMOTE_VALUE_FORWARDING) &&
-          !syncAccessFunctionSet.set_in(parent)) {
+          !accessFunctionSet.set_in(parent)) {
 
-        syncAccessFunctionSet.set_add(parent);
-        syncAccessFunctionVec.add(parent);
+        accessFunctionSet.set_add(parent);
+        accessFunctionVec.add(parent);
 
 #ifdef DEBUG_SYNC_ACCESS_FUNCTION_SET
         printf("%s:%d %s\n",
@@ -0,0 +1,451 @@
+/*
+ * Copyright 2004-2018 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//
+// Strength reduction of array accesses in loops (--strength-reduction)
+//
+// Every access to a DefaultRectangular array computes the position of
+// the element from scratch: a sum over all dimensions of the index times
+// the dimension's multiplier, plus a division by the stride in each
+// dimension of a stridable array.  In a serial loop over k, an access
+//
+//   for k in ... do ... A[i, k] ...
+//
+// where all indices but k are loop invariant can instead use a base and
+// a stride computed once before the loop:
+//
+//   const base   = chpl__dimAccessBase(A, 2, i, 0),
+//         stride = chpl__dimAccessStride(A, 2);
+//   for k in ... do ... chpl__dimAccess(base, stride, k) ...
+//
+// chpl__dimAccess(base, stride, k) is base[k*stride] for a non-stridable
+// array, which the back-end compiler turns into a pointer increment and
+// can vectorize.  The helpers live in modules/internal/DefaultRectangular.
+//
+// This runs as each user function is resolved, so that the calls it
+// creates can be resolved in turn.  The base would be stale if the
+// array were reallocated within the loop, so the loop may only call
+// inline functions, whose bodies are checked in turn.  Bounds checks
+// would be lost, so the transformation is limited to --no-checks.
+//
+
+#include "optimizations.h"
+
+#include "astutil.h"
+#include "driver.h"
+#include "expr.h"
+#include "ForLoop.h"
+#include "resolution.h"
+#include "stlUtil.h"
+#include "stmt.h"
+#include "stringutil.h"
+#include "symbol.h"
+#include "type.h"
+#include "UnmanagedClassType.h"
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+  // An access A[i1, ..., k, ..., in] that varies only in dimension 'dim'
+  struct DimAccess {
+    Expr*                expr;     // the CallExpr or ContextCallExpr
+    Symbol*              array;
+    int                  dim;
+    std::vector<Symbol*> indices;  // NULL in dimension 'dim'
+  };
+
+  // The base and stride computed before the loop for one array, dimension
+  // and set of invariant indices
+  struct DimAccessTemps {
+    Symbol* base;
+    Symbol* stride;
+  };
+}
+
+static Symbol*   loopIndexVar(ForLoop* loop);
+static bool      mayReallocate(Expr* expr, std::set<FnSymbol*>& checked);
+static bool      isOnOrTaskBlock(CallExpr* call);
+static bool      isDefaultRectangularAccess(CallExpr* call);
+static bool      findDimAccess(Expr*     expr,
+                               CallExpr* call,
+                               ForLoop*  loop,
+                               Symbol*   idx,
+                               DimAccess& access);
+static bool      isLoopInvariantIndex(Symbol* sym, ForLoop* loop);
+static void      strengthReduceLoop(ForLoop* loop);
+static DimAccessTemps hoistBaseAndStride(ForLoop* loop, DimAccess& access);
+static void      replaceAccess(DimAccess&      access,
+                               DimAccessTemps& temps,
+                               Symbol*         idx);
+static void      reportStrengthReduction(DimAccess& access);
+
+void strengthReduceArrayAccesses(FnSymbol* fn) {
+  if (fNoStrengthReduction == true || fNoBoundsChecks == false) {
+    return;
+  }
+
+  if (fn->getModule()->modTag != MOD_USER) {
+    return;
+  }
+
+  std::vector<BaseAST*> asts;
+
+  collect_asts(fn->body, asts);
+
+  for_vector(BaseAST, ast, asts) {
+    if (ForLoop* loop = toForLoop(ast)) {
+      strengthReduceLoop(loop);
+    }
+  }
+}
+
+static void strengthReduceLoop(ForLoop* loop) {
+  Symbol* idx = loopIndexVar(loop);
+
+  if (idx == NULL) {
+    return;
+  }
+
+  std::set<FnSymbol*> checked;
+
+  if (mayReallocate(loop, checked) == true) {
+    return;
+  }
+
+  std::vector<DimAccess> accesses;
+  std::vector<BaseAST*>  asts;
+
+  collect_asts(loop, asts);
+
+  for_vector(BaseAST, ast, asts) {
+    DimAccess access;
+
+    if (ContextCallExpr* cc = toContextCallExpr(ast)) {
+      CallExpr* refCall = cc->getRefCall();
+
+      if (findDimAccess(cc, refCall, loop, idx, access) == true) {
+        accesses.push_back(access);
+      }
+
+    } else if (CallExpr* call = toCallExpr(ast)) {
+      if (isContextCallExpr(call->parentExpr) == false &&
+          findDimAccess(call, call, loop, idx, access) == true) {
+        accesses.push_back(access);
+      }
+    }
+  }
+
+  std::map<std::vector<Symbol*>, DimAccessTemps> hoisted;
+
+  for (size_t i = 0; i < accesses.size(); i++) {
+    DimAccess&           access = accesses[i];
+    std::vector<Symbol*> key    = access.indices;
+
+    key.push_back(access.array);
+
+    if (hoisted.count(key) == 0) {
+      hoisted[key] = hoistBaseAndStride(loop, access);
+    }
+
+    replaceAccess(access, hoisted[key], idx);
+
+    reportStrengthReduction(access);
+  }
+}
+
+//
+// The user's index variable: the loop moves its internal index into it
+// at the top of each iteration.  Destructured indices are not handled.
+//
+static Symbol* loopIndexVar(ForLoop* loop) {
+  Symbol* loopIdx = loop->indexGet()->symbol();
+  Symbol* retval  = NULL;
+
+  for_alist(stmt, loop->body) {
+    if (CallExpr* call = toCallExpr(stmt)) {
+      if (call->isPrimitive(PRIM_MOVE) == true) {
+        SymExpr* lhs = toSymExpr(call->get(1));
+        SymExpr* rhs = toSymExpr(call->get(2));
+
+        if (rhs != NULL && rhs->symbol() == loopIdx) {
+          if (lhs->symbol()->hasFlag(FLAG_INDEX_VAR) == true &&
+              lhs->symbol()->defPoint->parentExpr == loop) {
+            retval = lhs->symbol();
+          }
+
+          break;
+        }
+      }
+    }
+  }
+
+  return retval;
+}
+
+//
+// Could executing 'expr' reallocate an array?  Only primitives and calls
+// to inline functions that themselves could not are considered safe.
+// On and task blocks are not: the hoisted base is a narrow pointer that is
+// only valid on the locale where it was computed.
+//
+static bool mayReallocate(Expr* expr, std::set<FnSymbol*>& checked) {
+  std::vector<CallExpr*> calls;
+  bool                   retval = false;
+
+  collectCallExprs(expr, calls);
+
+  for_vector(CallExpr, call, calls) {
+    if (isOnOrTaskBlock(call) == true) {
+      retval = true;
+      break;
+
+    } else if (call->isPrimitive() == false) {
+      FnSymbol* fn = call->resolvedFunction();
+
+      if (fn == NULL || fn->hasFlag(FLAG_INLINE) == false ||
+          isTaskFun(fn) == true) {
+        retval = true;
+
+      } else if (checked.insert(fn).second == true) {
+        retval = mayReallocate(fn->body, checked);
+      }
+
+      if (retval == true) {
+        break;
+      }
+    }
+  }
+
+  return retval;
+}
+
+// Is 'call' the blockInfo of an on, begin, cobegin or coforall block?
+static bool isOnOrTaskBlock(CallExpr* call) {
+  return call->isPrimitive(PRIM_BLOCK_ON)          == true ||
+         call->isPrimitive(PRIM_BLOCK_BEGIN_ON)    == true ||
+         call->isPrimitive(PRIM_BLOCK_COBEGIN_ON)  == true ||
+         call->isPrimitive(PRIM_BLOCK_COFORALL_ON) == true ||
+         call->isPrimitive(PRIM_BLOCK_BEGIN)       == true ||
+         call->isPrimitive(PRIM_BLOCK_COBEGIN)     == true ||
+         call->isPrimitive(PRIM_BLOCK_COFORALL)    == true;
+}
+
+// Is 'call' an element access A[i1, ..., in] of a DefaultRectangular array?
+static bool isDefaultRectangularAccess(CallExpr* call) {
+  FnSymbol* fn     = call->resolvedFunction();
+  bool      retval = false;
+
+  if (fn != NULL && fn->name == astrThis && call->numActuals() >= 3) {
+    SymExpr*       mt = toSymExpr(call->get(1));
+    AggregateType* at = toAggregateType(call->get(2)->getValType());
+
+    if (mt != NULL && mt->symbol() == gMethodToken &&
+        at != NULL && at->symbol->hasFlag(FLAG_ARRAY) == true) {
+      Symbol*        instance = at->getField("_instance", false);
+      AggregateType* arr      = NULL;
+
+      if (instance != NULL) {
+        arr = toAggregateType(canonicalClassType(instance->type));
+      }
+
+      while (arr != NULL && arr->instantiatedFrom != NULL) {
+        arr = arr->instantiatedFrom;
+      }
+
+      retval = arr != NULL &&
+               arr->symbol->name == astr("DefaultRectangularArr");
+    }
+  }
+
+  return retval;
+}
+
+//
+// Does 'call' access an array that is defined outside of the loop with
+// the loop index in exactly one dimension and loop invariant indices in
+// all others?
+//
+static bool findDimAccess(Expr*      expr,
+                          CallExpr*  call,
+                          ForLoop*   loop,
+                          Symbol*    idx,
+                          DimAccess& access) {
+  if (call == NULL || isDefaultRectangularAccess(call) == false) {
+    return false;
+  }
+
+  SymExpr* arraySE = toSymExpr(call->get(2));
+
+  if (arraySE == NULL || loop->contains(arraySE->symbol()->defPoint)) {
+    return false;
+  }
+
+  // The access must be the value of a temporary
+  CallExpr* move = toCallExpr(expr->parentExpr);
+
+  if (move == NULL || move->isPrimitive(PRIM_MOVE) == false) {
+    return false;
+  }
+
+  access.expr  = expr;
+  access.array = arraySE->symbol();
+  access.dim   = 0;
+  access.indices.clear();
+
+  for (int i = 3; i <= call->numActuals(); i++) {
+    SymExpr* se  = toSymExpr(call->get(i));
+    Type*    t   = se != NULL ? se->symbol()->type : NULL;
+
+    if (se == NULL || (is_int_type(t) == false && is_uint_type(t) == false)) {
+      return false;
+
+    } else if (se->symbol() == idx) {
+      if (access.dim != 0) {
+        return false;
+      }
+
+      access.dim = i - 2;
+      access.indices.push_back(NULL);
+
+    } else if (isLoopInvariantIndex(se->symbol(), loop) == true) {
+      access.indices.push_back(se->symbol());
+
+    } else {
+      return false;
+    }
+  }
+
+  return access.dim != 0;
+}
+
+//
+// Conservatively, an index is loop invariant if it is a constant defined
+// outside of the loop: a literal, a 'const', the index of an enclosing
+// loop or a formal that cannot be modified.
+//
+static bool isLoopInvariantIndex(Symbol* sym, ForLoop* loop) {
+  bool retval = false;
+
+  if (sym->isImmediate() == true) {
+    retval = true;
+
+  } else if (sym->isRef() == true || loop->contains(sym->defPoint) == true) {
+    retval = false;
+
+  } else if (ArgSymbol* arg = toArgSymbol(sym)) {
+    retval = arg->intent == INTENT_BLANK    ||
+             arg->intent == INTENT_CONST    ||
+             arg->intent == INTENT_CONST_IN ||
+             arg->intent == INTENT_PARAM;
+
+  } else {
+    retval = sym->hasFlag(FLAG_CONST)     == true ||
+             sym->hasFlag(FLAG_INDEX_VAR) == true;
+  }
+
+  return retval;
+}
+
+static DimAccessTemps hoistBaseAndStride(ForLoop* loop, DimAccess& access) {
+  SET_LINENO(loop);
+
+  BlockStmt*     holder     = new BlockStmt(BLOCK_SCOPELESS);
+  VarSymbol*     base       = newTemp("chpl_dimAccessBase");
+  VarSymbol*     stride     = newTemp("chpl_dimAccessStride");
+  CallExpr*      baseCall   = new CallExpr("chpl__dimAccessBase",
+                                           access.array,
+                                           new_IntSymbol(access.dim));
+  CallExpr*      strideCall = new CallExpr("chpl__dimAccessStride",
+                                           access.array,
+                                           new_IntSymbol(access.dim));
+  DimAccessTemps retval;
+
+  for (size_t i = 0; i < access.indices.size(); i++) {
+    Symbol* index = access.indices[i];
+
+    baseCall->insertAtTail(index != NULL ? index : new_IntSymbol(0));
+  }
+
+  holder->insertAtTail(new DefExpr(base));
+  holder->insertAtTail(new CallExpr(PRIM_MOVE, base, baseCall));
+  holder->insertAtTail(new DefExpr(stride));
+  holder->insertAtTail(new CallExpr(PRIM_MOVE, stride, strideCall));
+
+  loop->insertBefore(holder);
+
+  resolveBlockStmt(holder);
+
+  holder->flattenAndRemove();
+
+  retval.base   = base;
+  retval.stride = stride;
+
+  return retval;
+}
+
+static void replaceAccess(DimAccess&      access,
+                          DimAccessTemps& temps,
+                          Symbol*         idx) {
+  SET_LINENO(access.expr);
+
+  CallExpr* move   = toCallExpr(access.expr->parentExpr);
+  CallExpr* call   = new CallExpr("chpl__dimAccess",
+                                  temps.base,
+                                  temps.stride,
+                                  idx);
+
+  access.expr->replace(call);
+
+  resolveCallAndCallee(call);
+
+  // The temporary may hold the value rather than a reference
+  if (move->get(1)->isRef() == false) {
+    CallExpr* deref = new CallExpr(PRIM_DEREF);
+
+    call->replace(deref);
+    deref->insertAtTail(call);
+  }
+}
+
+//
+// A loop in a generic function is resolved once per instantiation;
+// report each source location only once.
+//
+static void reportStrengthReduction(DimAccess& access) {
+  static std::set<std::string> reported;
+
+  if (fReportStrengthReduction == true) {
+    Expr*       expr = access.expr;
+    std::string loc  = std::string(expr->fname()) + ":" +
+                       istr(expr->linenum()) + ":" +
+                       access.array->name + ":" +
+                       istr(access.dim);
+
+    if (reported.insert(loc).second == true) {
+      printf("Strength-reduced access to %s in dimension %d (%s:%d)\n",
+             access.array->name,
+             access.dim,
+             expr->fname(),
+             expr->linenum());
+    }
+  }
+}
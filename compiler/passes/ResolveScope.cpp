@@ -255,6 +255,7 @@ void ResolveScope::addBuiltIns() {
   extend(gPrivatization);
   extend(gLocal);
   extend(gWarnUnstable);
+  extend(gVectorize);
   extend(gNodeID);
 }
 
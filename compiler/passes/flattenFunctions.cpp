@@ -352,13 +352,16 @@ addVarsToActuals(CallExpr* call, SymbolMap* vars, bool outerCall) {
 }
 
 void flattenNestedFunctions(Vec<FnSymbol*>& nestedFunctions) {
-  compute_call_sites();
-
   Vec<FnSymbol*> outerFunctionSet;
   Vec<FnSymbol*> nestedFunctionSet;
 
-  forv_Vec(FnSymbol, fn, nestedFunctions)
+  // Only the callers of the functions being flattened are needed, so
+  // avoid recomputing every call site in the program.  This matters
+  // because lowerIterators and parallel flatten one function at a time.
+  forv_Vec(FnSymbol, fn, nestedFunctions) {
     nestedFunctionSet.set_add(fn);
+    update_fn_call_sites(fn);
+  }
 
   Map<FnSymbol*,SymbolMap*> args_map;
 
@@ -430,6 +433,7 @@ void flattenNestedFunctions(Vec<FnSymbol*>& nestedFunctions) {
               outerFunctionSet.set_add(parent);
               nestedFunctionSet.set_add(parent);
               nestedFunctions.add(parent);
+              update_fn_call_sites(parent);
 
 
               form_Map(SymbolMapElem, use, *uses) {
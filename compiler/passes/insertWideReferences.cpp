@@ -95,6 +95,16 @@
 //
 // --------------------------------------------------
 //
+// Every access through a wide pointer checks at runtime whether the data is
+// on the current locale before communicating. Once such a check is known to
+// succeed, later accesses through the same pointer (or through references
+// derived from it) can use narrow temporaries instead. We track these "known
+// local" pointers through each function, and version innermost loops on the
+// locality of the loop-invariant wide pointers they access, so that the
+// check is made once before the loop. See versionLoopsOnLocality().
+//
+// --------------------------------------------------
+//
 // The "local field" pragma is also implemented in this pass. Instead of
 // widening the lhs of PRIM_GET_MEMBER_VALUE, we leave it narrow. Later
 // we'll insert some runtime checks and temporaries to make it all work.
@@ -1624,13 +1634,15 @@ static void derefWideRefsToWideClasses()
 // addr field into a non-wide of otherwise the same type. Then, replace its
 // use with the non-wide version.
 //
-static void insertLocalTemp(Expr* expr) {
+// If 'check' is false, the caller already knows that the reference is local.
+//
+static void insertLocalTemp(Expr* expr, bool check = true) {
   SymExpr* se = toSymExpr(expr);
   Expr* stmt = expr->getStmtExpr();
   INT_ASSERT(se && stmt);
   SET_LINENO(se);
   VarSymbol* var = newTemp(astr("local_", se->symbol()->name), getNarrowType(se));
-  if (!fNoLocalChecks) {
+  if (check && !fNoLocalChecks) {
     stmt->insertBefore(new CallExpr(PRIM_LOCAL_CHECK, se->copy()));
   }
   stmt->insertBefore(new DefExpr(var));
@@ -1639,6 +1651,28 @@ static void insertLocalTemp(Expr* expr) {
 }
 
 
+//
+// Drop the wideness of an operand of a call being localized. In a local
+// block ('known' is NULL) the operand is asserted to be local. Otherwise it
+// is only narrowed if it is in the set of wide references known to be local.
+// Returns true if the operand was narrowed.
+//
+static bool localizeOperand(Expr* expr, const std::set<Symbol*>* known) {
+  if (known == NULL) {
+    insertLocalTemp(expr);
+    return true;
+  }
+
+  SymExpr* se = toSymExpr(expr);
+  if (se != NULL && known->count(se->symbol()) != 0) {
+    insertLocalTemp(expr, false);
+    return true;
+  }
+
+  return false;
+}
+
+
 //
 // If call has the potential to cause communication, assert that the wide
 // reference that might cause communication is local and remove its wide-ness
@@ -1646,21 +1680,27 @@ static void insertLocalTemp(Expr* expr) {
 // The organization of this function follows the order of CallExpr::codegen()
 // leaving out primitives that don't communicate.
 //
-static void localizeCall(CallExpr* call) {
+// Returns the number of operands narrowed.
+//
+static int localizeCall(CallExpr* call,
+                        const std::set<Symbol*>* known = NULL) {
+  int narrowed = 0;
+
   if (call->primitive) {
     switch (call->primitive->tag) {
     case PRIM_ARRAY_SET: /* Fallthru */
     case PRIM_ARRAY_SET_FIRST:
-      if (call->get(1)->typeInfo()->symbol->hasFlag(FLAG_WIDE_CLASS)) {
-        insertLocalTemp(call->get(1));
+      if (call->get(1)->typeInfo()->symbol->hasFlag(FLAG_WIDE_CLASS) &&
+          localizeOperand(call->get(1), known)) {
+        narrowed++;
       }
       break;
     case PRIM_MOVE:
     case PRIM_ASSIGN: // Not sure about this one.
       if (CallExpr* rhs = toCallExpr(call->get(2))) {
         if (rhs->isPrimitive(PRIM_DEREF)) {
-          if (isFullyWide(rhs->get(1))) {
-            insertLocalTemp(rhs->get(1));
+          if (isFullyWide(rhs->get(1)) && localizeOperand(rhs->get(1), known)) {
+            narrowed++;
           }
           break;
         }
@@ -1671,8 +1711,9 @@ static void localizeCall(CallExpr* call) {
           if (isFullyWide(rhs->get(1))) {
             SymExpr* sym = toSymExpr(rhs->get(2));
             INT_ASSERT(sym);
-            if (!sym->symbol()->hasFlag(FLAG_SUPER_CLASS)) {
-              insertLocalTemp(rhs->get(1));
+            if (!sym->symbol()->hasFlag(FLAG_SUPER_CLASS) &&
+                localizeOperand(rhs->get(1), known)) {
+              narrowed++;
             }
           }
           // TODO: insert a local temp for the lhs of this move
@@ -1685,7 +1726,10 @@ static void localizeCall(CallExpr* call) {
             INT_ASSERT(lhs && stmt);
 
             SET_LINENO(stmt);
-            insertLocalTemp(rhs->get(1));
+            if (!localizeOperand(rhs->get(1), known)) {
+              break;
+            }
+            narrowed++;
             VarSymbol* localVar = NULL;
             if (rhs->isPrimitive(PRIM_ARRAY_GET))
               localVar = newTemp(astr("local_", lhs->symbol()->name),
@@ -1700,14 +1744,16 @@ static void localizeCall(CallExpr* call) {
           }
           break;
         } else if (rhs->isPrimitive(PRIM_GET_UNION_ID)) {
-          if (rhs->get(1)->typeInfo()->symbol->hasFlag(FLAG_WIDE_REF)) {
-            insertLocalTemp(rhs->get(1));
+          if (rhs->get(1)->typeInfo()->symbol->hasFlag(FLAG_WIDE_REF) &&
+              localizeOperand(rhs->get(1), known)) {
+            narrowed++;
           }
           break;
         } else if (rhs->isPrimitive(PRIM_TESTCID) ||
                    rhs->isPrimitive(PRIM_GETCID)) {
-          if (rhs->get(1)->typeInfo()->symbol->hasFlag(FLAG_WIDE_CLASS)) {
-            insertLocalTemp(rhs->get(1));
+          if (rhs->get(1)->typeInfo()->symbol->hasFlag(FLAG_WIDE_CLASS) &&
+              localizeOperand(rhs->get(1), known)) {
+            narrowed++;
           }
           break;
         }
@@ -1718,13 +1764,15 @@ static void localizeCall(CallExpr* call) {
         break;
       }
       if (call->get(1)->typeInfo()->symbol->hasFlag(FLAG_WIDE_REF) &&
-          !call->get(2)->isRefOrWideRef()) {
-        insertLocalTemp(call->get(1));
+          !call->get(2)->isRefOrWideRef() &&
+          localizeOperand(call->get(1), known)) {
+        narrowed++;
       }
       break;
     case PRIM_DYNAMIC_CAST:
-      if (call->get(2)->typeInfo()->symbol->hasFlag(FLAG_WIDE_CLASS)) {
-        insertLocalTemp(call->get(2));
+      if (call->get(2)->typeInfo()->symbol->hasFlag(FLAG_WIDE_CLASS) &&
+          localizeOperand(call->get(2), known)) {
+        narrowed++;
         if (isFullyWide(call->get(1))) {
           Symbol* se = toSymExpr(call->get(1))->symbol();
           QualifiedType qt = getNarrowType(call->get(1));
@@ -1734,27 +1782,29 @@ static void localizeCall(CallExpr* call) {
       }
       break;
     case PRIM_SETCID:
-      if (call->get(1)->typeInfo()->symbol->hasFlag(FLAG_WIDE_CLASS)) {
-        insertLocalTemp(call->get(1));
+      if (call->get(1)->typeInfo()->symbol->hasFlag(FLAG_WIDE_CLASS) &&
+          localizeOperand(call->get(1), known)) {
+        narrowed++;
       }
       break;
     case PRIM_SET_UNION_ID:
-      if (call->get(1)->typeInfo()->symbol->hasFlag(FLAG_WIDE_REF)) {
-        insertLocalTemp(call->get(1));
+      if (call->get(1)->typeInfo()->symbol->hasFlag(FLAG_WIDE_REF) &&
+          localizeOperand(call->get(1), known)) {
+        narrowed++;
       }
       break;
     case PRIM_SET_MEMBER:
     case PRIM_SET_SVEC_MEMBER:
-      if (isFullyWide(call->get(1))) {
-        insertLocalTemp(call->get(1));
+      if (isFullyWide(call->get(1)) && localizeOperand(call->get(1), known)) {
+        narrowed++;
       }
       break;
     case PRIM_MULT_ASSIGN:
     case PRIM_ADD_ASSIGN:
     case PRIM_SUBTRACT_ASSIGN:
     case PRIM_DIV_ASSIGN:
-      if (isFullyWide(call->get(1))) {
-        insertLocalTemp(call->get(1));
+      if (isFullyWide(call->get(1)) && localizeOperand(call->get(1), known)) {
+        narrowed++;
       }
       break;
     default:
@@ -1762,6 +1812,8 @@ static void localizeCall(CallExpr* call) {
       break;
     }
   }
+
+  return narrowed;
 }
 
 
@@ -1828,6 +1880,524 @@ static void handleLocalBlocks() {
 }
 
 
+//
+// Could the value of the variable referred to by 'se' change here? Besides
+// direct definitions, this includes taking its address and passing it to a
+// function by reference.
+//
+static bool mayRedefine(SymExpr* se) {
+  if (!isVarSymbol(se->symbol()) && !isArgSymbol(se->symbol())) {
+    return false;
+  }
+
+  if (isDefAndOrUse(se) & 1) {
+    return true;
+  }
+
+  CallExpr* call = toCallExpr(se->parentExpr);
+
+  if (call == NULL || se->isRefOrWideRef()) {
+    return false;
+  }
+
+  if (call->isPrimitive(PRIM_ADDR_OF) ||
+      call->isPrimitive(PRIM_SET_REFERENCE) ||
+      call->isPrimitive(PRIM_FTABLE_CALL)) {
+    return true;
+  }
+
+  if (call->isResolved() ||
+      (call->isPrimitive(PRIM_VIRTUAL_METHOD_CALL) &&
+       se != call->get(1) && se != call->get(2))) {
+    return actual_to_formal(se)->isRef();
+  }
+
+  return false;
+}
+
+
+static void killRedefined(Expr* expr, std::set<Symbol*>& known) {
+  if (known.empty() == false) {
+    std::vector<SymExpr*> symExprs;
+    collectSymExprs(expr, symExprs);
+    for_vector(SymExpr, se, symExprs) {
+      if (mayRedefine(se)) {
+        known.erase(se->symbol());
+      }
+    }
+  }
+}
+
+
+//
+// Is 'expr' a pointer to the current locale? Narrow class instances and
+// references always are.
+//
+static bool isKnownLocal(Expr* expr, const std::set<Symbol*>& known) {
+  SymExpr* se = toSymExpr(expr);
+  return se != NULL &&
+         (hasSomeWideness(se) == false || known.count(se->symbol()) != 0);
+}
+
+
+//
+// The rhs of a move into a wide reference or class. Is the result on the
+// same locale as a known local pointer? Copies are, and so are the
+// addresses of fields and elements of a known local instance or record.
+// The fields of a class instance referred to by a reference are not.
+//
+static bool preservesLocality(Expr* rhs, const std::set<Symbol*>& known) {
+  if (isSymExpr(rhs)) {
+    return isKnownLocal(rhs, known);
+  }
+
+  CallExpr* call = toCallExpr(rhs);
+  if (call != NULL &&
+      (call->isPrimitive(PRIM_GET_MEMBER) ||
+       call->isPrimitive(PRIM_GET_SVEC_MEMBER) ||
+       call->isPrimitive(PRIM_ARRAY_GET))) {
+    Expr* base = call->get(1);
+    return isKnownLocal(base, known) &&
+           !(base->isRefOrWideRef() && valIsWideClass(base));
+  }
+
+  return false;
+}
+
+
+//
+// A local check is made of a copy of the checked pointer. If 'sym' is only
+// defined by a copy of a wide pointer earlier in the same block as 'check',
+// and that pointer is not redefined in between, return it: the check tells
+// that it is local as well.
+//
+static Symbol* checkedCopySource(Symbol* sym, CallExpr* check) {
+  CallExpr* move = NULL;
+  int       defs = 0;
+
+  for_SymbolSymExprs(se, sym) {
+    if (isDefAndOrUse(se) & 1) {
+      defs++;
+    }
+  }
+
+  for (Expr* stmt = check->prev; stmt != NULL && move == NULL;
+       stmt = stmt->prev) {
+    CallExpr* call = toCallExpr(stmt);
+    DefExpr*  def  = toDefExpr(stmt);
+
+    if (def != NULL && isLabelSymbol(def->sym)) {
+      return NULL;
+    } else if (call != NULL && call->isPrimitive(PRIM_MOVE)) {
+      SymExpr* lhs = toSymExpr(call->get(1));
+      if (lhs != NULL && lhs->symbol() == sym) {
+        move = call;
+      }
+    }
+  }
+
+  SymExpr* rhs = move != NULL ? toSymExpr(move->get(2)) : NULL;
+
+  if (defs != 1 || rhs == NULL || isFullyWide(rhs) == false) {
+    return NULL;
+  }
+
+  std::set<Symbol*> source;
+  source.insert(rhs->symbol());
+
+  for (Expr* stmt = move->next; stmt != check; stmt = stmt->next) {
+    killRedefined(stmt, source);
+  }
+
+  return source.empty() ? NULL : rhs->symbol();
+}
+
+
+//
+// Forward dataflow over the statements of 'block': narrow the accesses
+// through wide references that are known to be local, and drop local checks
+// of references already known to be local.
+//
+// 'known' holds the references known to be local on entry, and 'invariant'
+// the ones known to be local everywhere in the block. A label can be
+// reached by gotos from anywhere, so only the invariant facts hold there.
+// Facts established within a nested loop or conditional are not carried
+// past it, but those established within a nested local block are. If
+// 'exitKnown' is not NULL, it is set to the facts that hold when control
+// falls off the end of 'block'.
+//
+// Returns the number of accesses narrowed and checks removed.
+//
+static int localizeKnownLocals(BlockStmt* block,
+                               std::set<Symbol*> known,
+                               const std::set<Symbol*>& invariant,
+                               std::set<Symbol*>* exitKnown = NULL) {
+  int   localized = 0;
+  Expr* next      = NULL;
+
+  for (Expr* stmt = block->body.head; stmt != NULL; stmt = next) {
+    next = stmt->next;
+
+    if (DefExpr* def = toDefExpr(stmt)) {
+      if (isLabelSymbol(def->sym)) {
+        known = invariant;
+      }
+
+    } else if (CallExpr* call = toCallExpr(stmt)) {
+      if (call->isPrimitive(PRIM_LOCAL_CHECK)) {
+        SymExpr* se = toSymExpr(call->get(1));
+        if (se != NULL && known.count(se->symbol()) != 0) {
+          call->remove();
+          localized++;
+        } else if (se != NULL && isFullyWide(se)) {
+          known.insert(se->symbol());
+          if (Symbol* source = checkedCopySource(se->symbol(), call)) {
+            known.insert(source);
+          }
+        }
+        continue;
+      }
+
+      // Visit any statements inserted after the call as well
+      if (known.empty() == false) {
+        localized += localizeCall(call, &known);
+        next = call->next;
+      }
+
+      killRedefined(call, known);
+
+      if (call->isPrimitive(PRIM_MOVE)) {
+        SymExpr* lhs = toSymExpr(call->get(1));
+        if (isDefAndOrUse(lhs) == 1 && isFullyWide(lhs) &&
+            preservesLocality(call->get(2), known)) {
+          known.insert(lhs->symbol());
+        }
+      }
+
+    } else if (BlockStmt* inner = toBlockStmt(stmt)) {
+      if (inner->isLoopStmt()) {
+        // Facts must also hold on the back edge.
+        killRedefined(inner, known);
+        localized += localizeKnownLocals(inner, known, invariant);
+      } else {
+        // Straight-line code: what holds at its end holds after it.
+        // Anything after it reached by a goto starts at a label.
+        std::set<Symbol*> after;
+
+        localized += localizeKnownLocals(inner, known, invariant, &after);
+        known.swap(after);
+      }
+
+    } else if (CondStmt* cond = toCondStmt(stmt)) {
+      localized += localizeKnownLocals(cond->thenStmt, known, invariant);
+      if (cond->elseStmt != NULL) {
+        localized += localizeKnownLocals(cond->elseStmt, known, invariant);
+      }
+      killRedefined(cond, known);
+
+    } else {
+      killRedefined(stmt, known);
+    }
+  }
+
+  if (exitKnown != NULL) {
+    exitKnown->swap(known);
+  }
+
+  return localized;
+}
+
+
+//
+// Narrowing an access leaves a wide temporary that is built from a narrow
+// pointer and only read to be narrowed again. Make such temporaries in
+// 'block' narrow, so that the current locale is not looked up for them.
+//
+static void narrowLocalTemps(BlockStmt* block) {
+  std::vector<DefExpr*> defs;
+
+  collectDefExprs(block, defs);
+
+  for_vector(DefExpr, def, defs) {
+    VarSymbol* var    = toVarSymbol(def->sym);
+    bool       narrow = var != NULL && isFullyWide(var);
+
+    if (narrow == false) {
+      continue;
+    }
+
+    for_SymbolSymExprs(se, var) {
+      CallExpr* move = toCallExpr(se->parentExpr);
+
+      if (move == NULL || move->isPrimitive(PRIM_MOVE) == false ||
+          isSymExpr(move->get(2)) == false) {
+        narrow = false;
+      } else if (move->get(1) == se) {
+        narrow = hasSomeWideness(move->get(2)) == false;
+      } else {
+        narrow = hasSomeWideness(move->get(1)) == false;
+      }
+
+      if (narrow == false) {
+        break;
+      }
+    }
+
+    if (narrow) {
+      QualifiedType qt = getNarrowType(var);
+      var->type = qt.type();
+      var->qual = qt.getQual();
+    }
+  }
+}
+
+
+//
+// Local checks are inserted for every access in a local block. Once a check
+// has passed, the later checks of the same reference are redundant, and the
+// accesses through it after the local block need not communicate either.
+//
+static void removeRedundantLocalChecks() {
+  std::set<FnSymbol*> fns;
+
+  forv_Vec(CallExpr, call, gCallExprs) {
+    if (call->isPrimitive(PRIM_LOCAL_CHECK) && call->inTree()) {
+      fns.insert(call->getFunction());
+    }
+  }
+
+  for_set(FnSymbol, fn, fns) {
+    std::set<Symbol*> none;
+    localizeKnownLocals(fn->body, none, none);
+  }
+}
+
+
+//
+// The loop-invariant wide references through which 'loop' accesses data.
+// A candidate is a local variable or formal of 'fn' that is not redefined
+// in the loop and whose address is not taken anywhere in 'fn'.
+//
+static void findLocalityCandidates(FnSymbol* fn,
+                                   BlockStmt* loop,
+                                   std::vector<Symbol*>& candidates) {
+  std::vector<SymExpr*> symExprs;
+  std::set<Symbol*>     redefined;
+
+  collectSymExprs(loop, symExprs);
+
+  for_vector(SymExpr, se, symExprs) {
+    if (mayRedefine(se)) {
+      redefined.insert(se->symbol());
+    }
+  }
+
+  std::set<Symbol*> accessed;
+
+  for_vector(SymExpr, se, symExprs) {
+    Symbol*   sym  = se->symbol();
+    CallExpr* call = toCallExpr(se->parentExpr);
+
+    if (call == NULL || se == call->baseExpr || call->get(1) != se ||
+        isFullyWide(se) == false ||
+        redefined.count(sym) != 0 || isGlobal(sym) ||
+        sym->defPoint->parentSymbol != fn || loop->contains(sym->defPoint)) {
+      continue;
+    }
+
+    // An access that may communicate: a load, a store, or the address
+    // of a field or element used as such
+    if (call->isPrimitive(PRIM_DEREF) ||
+        call->isPrimitive(PRIM_GET_MEMBER) ||
+        call->isPrimitive(PRIM_GET_SVEC_MEMBER) ||
+        call->isPrimitive(PRIM_GET_MEMBER_VALUE) ||
+        call->isPrimitive(PRIM_GET_SVEC_MEMBER_VALUE) ||
+        call->isPrimitive(PRIM_ARRAY_GET) ||
+        call->isPrimitive(PRIM_ARRAY_GET_VALUE) ||
+        call->isPrimitive(PRIM_SET_MEMBER) ||
+        call->isPrimitive(PRIM_SET_SVEC_MEMBER) ||
+        call->isPrimitive(PRIM_ARRAY_SET) ||
+        call->isPrimitive(PRIM_ARRAY_SET_FIRST) ||
+        isOpEqualPrim(call) ||
+        (call->isPrimitive(PRIM_MOVE) && sym->isRefOrWideRef() &&
+         !call->get(2)->isRefOrWideRef())) {
+      accessed.insert(sym);
+    }
+  }
+
+  for_set(Symbol, sym, accessed) {
+    bool escapes = false;
+
+    if (sym->isRefOrWideRef() == false) {
+      for_SymbolSymExprs(se, sym) {
+        if (se->getFunction() == fn && mayRedefine(se) &&
+            isDefAndOrUse(se) != 1) {
+          escapes = true;
+          break;
+        }
+      }
+    }
+
+    if (escapes == false) {
+      candidates.push_back(sym);
+    }
+  }
+}
+
+
+//
+// Inlining can copy a loop; report each location only once. Compiler
+// temporaries are not named.
+//
+static void reportLocalityVersioning(BlockStmt*                  loop,
+                                     const std::vector<Symbol*>& syms) {
+  static std::set<std::string> reported;
+
+  ModuleSymbol* mod = loop->getModule();
+
+  if (fReportLocalityVersioning == true &&
+      (developer == true || mod->modTag == MOD_USER)) {
+    std::string names;
+
+    for_vector(Symbol, sym, syms) {
+      if (sym->hasFlag(FLAG_TEMP) == false) {
+        names += names.empty() ? " of " : ", ";
+        names += sym->name;
+      }
+    }
+
+    std::string loc = std::string(loop->fname()) + ":" +
+                      istr(loop->linenum()) + names;
+
+    if (reported.insert(loc).second == true) {
+      printf("Versioned loop on locality%s (%s:%d)\n",
+             names.c_str(),
+             loop->fname(),
+             loop->linenum());
+    }
+  }
+}
+
+
+//
+// Version 'loop' on whether the wide references in 'syms' are local:
+//
+//   if (all of syms are local) {
+//     <copy of loop with accesses through syms narrowed>
+//   } else {
+//     <loop>
+//   }
+//
+// The accesses in the copy need no runtime check of their own, so a
+// single-locale run of a multi-locale program pays one check per loop
+// instead of one per access.
+//
+static bool versionLoopOnLocality(BlockStmt*                  loop,
+                                  const std::vector<Symbol*>& syms) {
+  SET_LINENO(loop);
+
+  VarSymbol*        isLocal = newTemp("isLocal", dtBool);
+  BlockStmt*        local   = loop->copy();
+  BlockStmt*        remote  = new BlockStmt();
+  CondStmt*         cond    = new CondStmt(new SymExpr(isLocal),
+                                           new BlockStmt(local),
+                                           remote);
+  std::set<Symbol*> known(syms.begin(), syms.end());
+
+  loop->insertBefore(cond);
+  remote->insertAtTail(loop->remove());
+
+  if (localizeKnownLocals(local, known, known) == 0) {
+    cond->insertBefore(loop->remove());
+    cond->remove();
+    return false;
+  }
+
+  narrowLocalTemps(local);
+
+  VarSymbol* here = newTemp("here", NODE_ID_TYPE);
+
+  cond->insertBefore(new DefExpr(isLocal));
+  cond->insertBefore(new DefExpr(here));
+  cond->insertBefore(new CallExpr(PRIM_MOVE, isLocal, gTrue));
+
+  for_vector(Symbol, sym, syms) {
+    VarSymbol* narrow = newTemp(astr("local_", sym->name), getNarrowType(sym));
+    VarSymbol* node   = newTemp("node", NODE_ID_TYPE);
+    VarSymbol* same   = newTemp("same", dtBool);
+
+    cond->insertBefore(new DefExpr(narrow));
+    cond->insertBefore(new DefExpr(node));
+    cond->insertBefore(new DefExpr(same));
+    cond->insertBefore(new CallExpr(PRIM_MOVE, narrow, sym));
+    cond->insertBefore(new CallExpr(PRIM_MOVE, node,
+                                    new CallExpr(PRIM_WIDE_GET_NODE, sym)));
+
+    // The node of a narrow pointer is the current node
+    if (sym == syms.front()) {
+      cond->insertBefore(new CallExpr(PRIM_MOVE, here,
+                                      new CallExpr(PRIM_WIDE_GET_NODE,
+                                                   narrow)));
+    }
+
+    cond->insertBefore(new CallExpr(PRIM_MOVE, same,
+                                    new CallExpr(PRIM_EQUAL, node, here)));
+    cond->insertBefore(new CallExpr(PRIM_MOVE, isLocal,
+                                    new CallExpr(PRIM_AND, isLocal, same)));
+  }
+
+  reportLocalityVersioning(loop, syms);
+
+  return true;
+}
+
+
+static bool containsLoop(BlockStmt* loop) {
+  std::vector<Expr*> stmts;
+
+  collect_stmts(loop, stmts);
+
+  for_vector(Expr, stmt, stmts) {
+    BlockStmt* block = toBlockStmt(stmt);
+    if (block != NULL && block != loop && block->isLoopStmt()) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+
+//
+// Version the innermost loops on the locality of the loop-invariant wide
+// references they access. Only innermost loops are versioned, so that the
+// code grows at most twofold.
+//
+static void versionLoopsOnLocality() {
+  std::vector<BlockStmt*> loops;
+
+  forv_Vec(BlockStmt, block, gBlockStmts) {
+    if (block->isLoopStmt() && block->inTree() &&
+        block->getFunction() != NULL &&
+        !block->getFunction()->hasFlag(FLAG_LOCAL_FN)) {
+      if (containsLoop(block) == false) {
+        loops.push_back(block);
+      }
+    }
+  }
+
+  for_vector(BlockStmt, loop, loops) {
+    std::vector<Symbol*> syms;
+
+    findLocalityCandidates(loop->getFunction(), loop, syms);
+
+    if (syms.empty() == false) {
+      versionLoopOnLocality(loop, syms);
+    }
+  }
+}
+
+
 // Add symbols bearing the FLAG_HEAP flag to a list of heapVars.
 static void getHeapVars(std::vector<Symbol*>& heapVars)
 {
@@ -2491,6 +3061,12 @@ insertWideReferences(void) {
   derefWideRefsToWideClasses();
 
   handleLocalBlocks();
+
+  if (fNoLocalityVersioning == false) {
+    removeRedundantLocalChecks();
+    versionLoopsOnLocality();
+  }
+
   heapAllocateGlobalsTail(heapAllocateGlobals, heapVars);
 
   // NWR
@@ -33,6 +33,7 @@
 #include "initializerRules.h"
 #include "library.h"
 #include "LoopExpr.h"
+#include "optimizations.h"
 #include "stlUtil.h"
 #include "stringutil.h"
 #include "TransformLogicalShortCircuit.h"
@@ -142,6 +143,10 @@ void normalize() {
 
   handleReduceAssign();
 
+  autoAggregation();
+
+  forallFusion();
+
   forv_Vec(AggregateType, at, gAggregateTypes) {
     if (isClassWithInitializers(at)  == true ||
         isRecordWithInitializers(at) == true) {
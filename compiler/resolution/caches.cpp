@@ -33,10 +33,13 @@
 SymbolMapCache genericsCache;
 SymbolMapCache promotionsCache;
 
-static bool isCacheEntryMatch(SymbolMap* s1, SymbolMap* s2);
+static uintptr_t hashSymbolMap(SymbolMap* map);
+static bool      isCacheEntryMatch(SymbolMap* s1, SymbolMap* s2);
 
-SymbolMapCacheEntry::SymbolMapCacheEntry(FnSymbol* ifn, SymbolMap* imap) :
-  fn(ifn), map(*imap) { }
+SymbolMapCacheEntry::SymbolMapCacheEntry(FnSymbol*  ifn,
+                                         SymbolMap* imap,
+                                         uintptr_t  ihash) :
+  fn(ifn), map(*imap), hash(ihash) { }
 
 
 void
@@ -45,7 +48,8 @@ addCache(SymbolMapCache& cache,
          FnSymbol*       fn,
          SymbolMap*      map) {
   Vec<SymbolMapCacheEntry*>* entries = cache.get(oldFn);
-  SymbolMapCacheEntry*       entry   = new SymbolMapCacheEntry(fn, map);
+  SymbolMapCacheEntry*       entry   = new SymbolMapCacheEntry(fn, map,
+                                                               hashSymbolMap(map));
 
   if (entries) {
     entries->add(entry);
@@ -61,8 +65,10 @@ addCache(SymbolMapCache& cache,
 FnSymbol*
 checkCache(SymbolMapCache& cache, FnSymbol* oldFn, SymbolMap* map) {
   if (Vec<SymbolMapCacheEntry*>* entries = cache.get(oldFn)) {
+    uintptr_t hash = hashSymbolMap(map);
+
     forv_Vec(SymbolMapCacheEntry, entry, *entries) {
-      if (isCacheEntryMatch(map, &entry->map))
+      if (entry->hash == hash && isCacheEntryMatch(map, &entry->map))
         return entry->fn;
     }
   }
@@ -76,8 +82,10 @@ replaceCache(SymbolMapCache& cache,
              FnSymbol*       fn,
              SymbolMap*      map) {
   if (Vec<SymbolMapCacheEntry*>* entries = cache.get(oldFn)) {
+    uintptr_t hash = hashSymbolMap(map);
+
     forv_Vec(SymbolMapCacheEntry, entry, *entries) {
-      if (isCacheEntryMatch(map, &entry->map)) {
+      if (entry->hash == hash && isCacheEntryMatch(map, &entry->map)) {
         entry->fn = fn;
         return;
       }
@@ -99,6 +107,27 @@ freeCache(SymbolMapCache& cache) {
   cache.clear();
 }
 
+//
+// Combine the key-value pairs in an order-independent way so that maps
+// that isCacheEntryMatch() considers equal hash alike.  Pairs with a NULL
+// value are skipped since they match a missing key.  The pointers
+// themselves are hashed because keys may have been deleted by now.
+//
+static uintptr_t hashSymbolMap(SymbolMap* map) {
+  uintptr_t retval = 0;
+
+  form_Map(SymbolMapElem, e, *map) {
+    if (e->value != NULL) {
+      uintptr_t key   = (uintptr_t) e->key;
+      uintptr_t value = (uintptr_t) e->value;
+
+      retval += (key * 0x9E3779B1u) ^ (value + (value >> 7));
+    }
+  }
+
+  return retval;
+}
+
 static bool isCacheEntryMatch(SymbolMap* s1, SymbolMap* s2) {
   form_Map(SymbolMapElem, e, *s1) {
     if (s2->get(e->key) != e->value) {
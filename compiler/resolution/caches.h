@@ -35,12 +35,16 @@
 //
 //   freeCache(cache): frees memory associated with cache
 //
+// Each entry remembers a hash of its map's contents so that a lookup
+// only compares maps whose hashes agree.
+//
 class SymbolMapCacheEntry {
 public:
-  SymbolMapCacheEntry(FnSymbol* ifn, SymbolMap* imap);
+  SymbolMapCacheEntry(FnSymbol* ifn, SymbolMap* imap, uintptr_t ihash);
 
   FnSymbol* fn;
   SymbolMap map;
+  uintptr_t hash;
 };
 
 typedef Map<FnSymbol*,     Vec<SymbolMapCacheEntry*>*> SymbolMapCache;
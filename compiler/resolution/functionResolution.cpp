@@ -45,6 +45,7 @@
 #include "ModuleSymbol.h"
 #include "ParamForLoop.h"
 #include "PartialCopyData.h"
+#include "passProfile.h"
 #include "passes.h"
 #include "postFold.h"
 #include "preFold.h"
@@ -147,6 +148,11 @@ static std::map<FnSymbol*, const char*> outerCompilerErrorMap;
 
 static CapturedValueMap            capturedValues;
 
+// Counts reported by --print-resolution-stats
+static int                         nNormalCallsResolved      = 0;
+static int                         nCandidatesConsidered     = 0;
+static int                         nCandidateMemoHits        = 0;
+
 
 //#
 //# Static Function Declarations
@@ -2205,6 +2211,8 @@ static FnSymbol* resolveNormalCall(CallInfo& info, bool checkOnly) {
 
   FnSymbol*                 retval     = NULL;
 
+  nNormalCallsResolved++;
+
   findVisibleFunctionsAndCandidates(info, mostApplicable, candidates);
 
   numMatches = disambiguateByMatch(info,
@@ -2847,17 +2855,23 @@ static void generateMsg(CallInfo& info, Vec<FnSymbol*>& visibleFns) {
 
 static void findVisibleCandidates(CallInfo&                  info,
                                   Vec<FnSymbol*>&            visibleFns,
-                                  Vec<ResolutionCandidate*>& candidates);
+                                  Vec<ResolutionCandidate*>& candidates,
+                                  std::vector<FnSymbol*>*    applicable);
 
 static void gatherCandidates(CallInfo&                  info,
                              Vec<FnSymbol*>&            visibleFns,
                              bool                       lastResort,
-                             Vec<ResolutionCandidate*>& candidates);
+                             Vec<ResolutionCandidate*>& candidates,
+                             std::vector<FnSymbol*>*    applicable);
 
-static void filterCandidate (CallInfo&                  info,
+static bool filterCandidate (CallInfo&                  info,
                              FnSymbol*                  fn,
                              Vec<ResolutionCandidate*>& candidates);
 
+static bool findMemoizedCandidates(CallInfo&                  info,
+                                   Vec<FnSymbol*>&            visibleFns,
+                                   Vec<ResolutionCandidate*>& candidates);
+
 
 void trimVisibleCandidates(CallInfo&       info,
                            Vec<FnSymbol*>& mostApplicable,
@@ -2950,27 +2964,162 @@ static void findVisibleFunctionsAndCandidates(
 
   trimVisibleCandidates(info, mostApplicable, visibleFns);
 
-  findVisibleCandidates(info, mostApplicable, candidates);
+  if (fn != NULL ||
+      findMemoizedCandidates(info, mostApplicable, candidates) == false) {
+    findVisibleCandidates(info, mostApplicable, candidates, NULL);
+  }
 
   explainGatherCandidate(info, candidates);
 }
 
 static void findVisibleCandidates(CallInfo&                  info,
                                   Vec<FnSymbol*>&            visibleFns,
-                                  Vec<ResolutionCandidate*>& candidates) {
+                                  Vec<ResolutionCandidate*>& candidates,
+                                  std::vector<FnSymbol*>*    applicable) {
   // Search user-defined (i.e. non-compiler-generated) functions first.
-  gatherCandidates(info, visibleFns, false, candidates);
+  gatherCandidates(info, visibleFns, false, candidates, applicable);
 
   // If no results, try again with any compiler-generated candidates.
   if (candidates.n == 0) {
-    gatherCandidates(info, visibleFns, true, candidates);
+    gatherCandidates(info, visibleFns, true, candidates, applicable);
+  }
+}
+
+/************************************* | **************************************
+*                                                                             *
+* Most candidates are rejected, and the same calls recur many times from the  *
+* internal modules (e.g. once per instantiation of a generic function).  The  *
+* applicable candidates are remembered under a key built from the call's      *
+* name, tags, and actuals.  If a later call has the same key and the same     *
+* visible functions, only the remembered candidates are filtered again.       *
+*                                                                             *
+* The key holds each actual's type, along with the state of that type that    *
+* filtering depends on and which can still change during resolution.  Param  *
+* and type actuals also contribute the symbol itself, since coercions of     *
+* params depend on their values.                                              *
+*                                                                             *
+************************************** | *************************************/
+
+typedef std::vector<void*> CandidateMemoKey;
+
+struct CandidateMemoEntry {
+  std::vector<FnSymbol*> visibleFns;
+  std::vector<FnSymbol*> applicable;
+};
+
+static std::map<CandidateMemoKey, CandidateMemoEntry> candidateMemo;
+
+static bool buildCandidateMemoKey(CallInfo& info, CandidateMemoKey& key) {
+  CallExpr* call = info.call;
+
+  if (explainCallLine != 0 || explainCallID != -1 ||
+      call->id == breakOnResolveID) {
+    return false;
+  }
+
+  key.push_back((void*) info.name);
+  key.push_back((void*) (intptr_t) ((call->methodTag  ? 1 : 0) |
+                                    (call->partialTag ? 2 : 0)));
+
+  for (int i = 0; i < info.actuals.n; i++) {
+    Symbol* actual = info.actuals.v[i];
+    Type*   t      = actual->type;
+
+    if (t->symbol->hasFlag(FLAG_GENERIC) == true) {
+      return false;
+    }
+
+    key.push_back((void*) info.actualNames.v[i]);
+    key.push_back((void*) t);
+    key.push_back((void*) t->scalarPromotionType);
+
+    if (actual->hasFlag(FLAG_TYPE_VARIABLE) == true ||
+        actual->isParameter()               == true ||
+        isTypeSymbol(actual)                == true) {
+      key.push_back((void*) actual);
+    } else {
+      key.push_back(NULL);
+    }
+
+    if (AggregateType* at = toAggregateType(t->getValType())) {
+      key.push_back((void*) (intptr_t) at->dispatchParents.n);
+    }
+  }
+
+  return true;
+}
+
+static bool sameVisibleFns(std::vector<FnSymbol*>& memo,
+                           Vec<FnSymbol*>&         visibleFns) {
+  if ((int) memo.size() != visibleFns.n) {
+    return false;
+  }
+
+  for (int i = 0; i < visibleFns.n; i++) {
+    if (memo[i] != visibleFns.v[i]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static bool findMemoizedCandidates(CallInfo&                  info,
+                                   Vec<FnSymbol*>&            visibleFns,
+                                   Vec<ResolutionCandidate*>& candidates) {
+  CandidateMemoKey key;
+
+  if (buildCandidateMemoKey(info, key) == false) {
+    return false;
+  }
+
+  std::map<CandidateMemoKey, CandidateMemoEntry>::iterator it;
+
+  it = candidateMemo.find(key);
+
+  if (it != candidateMemo.end() &&
+      sameVisibleFns(it->second.visibleFns, visibleFns) == true) {
+    bool allApplicable = true;
+
+    for_vector(FnSymbol, fn, it->second.applicable) {
+      if (filterCandidate(info, fn, candidates) == false) {
+        allApplicable = false;
+        break;
+      }
+    }
+
+    if (allApplicable == true) {
+      nCandidateMemoHits++;
+      return true;
+    }
+
+    // Something changed under us; forget the entry and search again
+    forv_Vec(ResolutionCandidate*, candidate, candidates) {
+      delete candidate;
+    }
+
+    candidates.clear();
+  }
+
+  // Filtering may resolve other calls, so fill in the entry afterwards
+  CandidateMemoEntry entry;
+
+  findVisibleCandidates(info, visibleFns, candidates, &entry.applicable);
+
+  for (int i = 0; i < visibleFns.n; i++) {
+    entry.visibleFns.push_back(visibleFns.v[i]);
   }
+
+  candidateMemo[key] = entry;
+
+  return true;
 }
 
 static void gatherCandidates(CallInfo&                  info,
                              Vec<FnSymbol*>&            visibleFns,
                              bool                       lastResort,
-                             Vec<ResolutionCandidate*>& candidates) {
+                             Vec<ResolutionCandidate*>& candidates,
+                             std::vector<FnSymbol*>*    applicable) {
   forv_Vec(FnSymbol, fn, visibleFns) {
     // Only consider functions marked with/without FLAG_LAST_RESORT
     // (where existence of the flag matches the lastResort argument)
@@ -3002,24 +3151,32 @@ static void gatherCandidates(CallInfo&                  info,
       // should be filtered against the available visibleFunctions.
       //
 
+      bool added = false;
+
       if (info.call->methodTag == false) {
-        filterCandidate(info, fn, candidates);
+        added = filterCandidate(info, fn, candidates);
 
       } else {
         if (fn->hasFlag(FLAG_NO_PARENS)        == true ||
             fn->hasFlag(FLAG_TYPE_CONSTRUCTOR) == true) {
-          filterCandidate(info, fn, candidates);
+          added = filterCandidate(info, fn, candidates);
         }
       }
+
+      if (added == true && applicable != NULL) {
+        applicable->push_back(fn);
+      }
     }
   }
 }
 
-static void filterCandidate(CallInfo&                  info,
+static bool filterCandidate(CallInfo&                  info,
                             FnSymbol*                  fn,
                             Vec<ResolutionCandidate*>& candidates) {
   ResolutionCandidate* candidate = new ResolutionCandidate(fn);
 
+  nCandidatesConsidered++;
+
   if (fExplainVerbose &&
       ((explainCallLine && explainCallMatch(info.call)) ||
        info.call->id == explainCallID)) {
@@ -3032,8 +3189,10 @@ static void filterCandidate(CallInfo&                  info,
 
   if (candidate->isApplicable(info) == true) {
     candidates.add(candidate);
+    return true;
   } else {
     delete candidate;
+    return false;
   }
 }
 
@@ -7097,6 +7256,8 @@ computeStandardModuleSet() {
 void resolve() {
   bool changed = true;
 
+  passProfileSubPhase("tagGenerics");
+
   parseExplainFlag(fExplainCall, &explainCallLine, &explainCallModule);
 
   computeStandardModuleSet(); // Lydia NOTE 09/12/16: is not linked to our
@@ -7120,6 +7281,8 @@ void resolve() {
 
   unmarkDefaultedGenerics();
 
+  passProfileSubPhase("resolveUses");
+
   resolveExternVarSymbols();
 
   resolveUses(ModuleSymbol::mainModule());
@@ -7136,6 +7299,8 @@ void resolve() {
 
   USR_STOP();
 
+  passProfileSubPhase("resolveOther");
+
   resolveExports();
 
   resolveEnumTypes();
@@ -7148,6 +7313,8 @@ void resolve() {
 
   resolveOther();
 
+  passProfileSubPhase("dynamicDispatch");
+
   resolveDynamicDispatches();
 
   // MPF - this 2nd resolveAutoCopies call is a workaround
@@ -7164,6 +7331,8 @@ void resolve() {
 
   insertDynamicDispatchCalls();
 
+  passProfileSubPhase("finishResolution");
+
   beforeLoweringForallStmts = false;
   resolveForallStmts1();
 
@@ -7185,17 +7354,31 @@ void resolve() {
   if (fPrintUnusedFns || fPrintUnusedInternalFns)
     printUnusedFunctions();
 
+  passProfileSubPhase("pruneResolvedTree");
+
   pruneResolvedTree();
 
   resolveForallStmts2();
 
+  passProfileSubPhase("cleanup");
+
   freeCache(defaultsCache);
 
   freeCache(genericsCache);
   freeCache(promotionsCache);
 
+  if (fPrintResolutionStats == true) {
+    fprintf(stderr, "normal calls resolved: %d\n", nNormalCallsResolved);
+    fprintf(stderr, "candidates considered: %d\n", nCandidatesConsidered);
+    fprintf(stderr, "calls using remembered candidates: %d\n",
+            nCandidateMemoHits);
+    visibleFunctionsPrintStats(stderr);
+  }
+
   visibleFunctionsClear();
 
+  candidateMemo.clear();
+
   std::map<int, SymbolMap*>::iterator it;
 
   for (it = capturedValues.begin(); it != capturedValues.end(); ++it) {
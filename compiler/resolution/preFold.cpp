@@ -22,6 +22,7 @@
 #include "astutil.h"
 #include "driver.h"
 #include "ForallStmt.h"
+#include "optimizations.h"
 #include "ParamForLoop.h"
 #include "passes.h"
 #include "resolution.h"
@@ -1026,6 +1027,18 @@ static Expr* preFoldPrimOp(CallExpr* call) {
                       gMethodToken, globalOp, lhs, rhs);
     call->replace(retval);
 
+  } else if (call->isPrimitive(PRIM_MAYBE_AGGREGATE_ASSIGN)) {
+    // Convert this 'call' into an aggregated copy or a plain assignment.
+    retval = lowerMaybeAggregateAssign(call);
+
+  } else if (call->isPrimitive(PRIM_MAYBE_AGGREGATE_ATOMIC)) {
+    // Convert this 'call' into an aggregated update or the original method.
+    retval = lowerMaybeAggregateAtomic(call);
+
+  } else if (call->isPrimitive(PRIM_FUSIBLE)) {
+    // Fold this 'call' into whether the statements it guards may be fused.
+    retval = lowerFusible(call);
+
   } else if (call->isPrimitive(PRIM_WIDE_GET_LOCALE) ||
              call->isPrimitive(PRIM_WIDE_GET_NODE)) {
     Type* type = call->get(1)->getValType();
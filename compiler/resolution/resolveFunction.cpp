@@ -31,6 +31,7 @@
 #include "iterator.h"
 #include "LoopExpr.h"
 #include "LoopStmt.h"
+#include "optimizations.h"
 #include "UnmanagedClassType.h"
 #include "ParamForLoop.h"
 #include "passes.h"
@@ -44,8 +45,6 @@
 #include "view.h"
 #include "WhileStmt.h"
 
-#include <set>
-
 static void resolveFormals(FnSymbol* fn);
 
 static void markIterator(FnSymbol* fn);
@@ -79,11 +78,13 @@ void resolveSignatureAndFunction(FnSymbol* fn) {
 void resolveSignature(FnSymbol* fn) {
   if (fn->hasFlag(FLAG_GENERIC) == false) {
     // Don't resolve formals for concrete functions
-    // more often than necessary.
-    static std::set<FnSymbol*> done;
+    // more often than necessary.  This is checked for every candidate
+    // of every call, so use a hashed set of node ids rather than a
+    // tree of pointers (ids are never reused, unlike addresses).
+    static Vec<int> done;
 
-    if (done.find(fn) == done.end()) {
-      done.insert(fn);
+    if (done.set_in(fn->id) == NULL) {
+      done.set_add(fn->id);
 
       resolveFormals(fn);
     }
@@ -424,6 +425,8 @@ void resolveFunction(FnSymbol* fn) {
       resolveBlockStmt(fn->body);
 
       if (tryFailure == false) {
+        strengthReduceArrayAccesses(fn);
+
         insertUnrefForArrayOrTupleReturn(fn);
 
         Type* yieldedType = NULL;
@@ -25,12 +25,14 @@
 #include "map.h"
 #include "resolution.h"
 #include "resolveIntents.h"
+#include "stlUtil.h"
 #include "stmt.h"
 #include "stringutil.h"
 #include "symbol.h"
 
 #include <map>
 #include <set>
+#include <vector>
 
 
 /*
@@ -61,6 +63,27 @@ static Map<BlockStmt*, VisibleFunctionBlock*> visibleFunctionMap;
 
 static int                                    nVisibleFunctions       = 0;
 
+/*
+   getVisibleFunctions walks up the scopes and through the 'use's of
+   each block, and a given call site repeats that walk for every
+   generic instantiation it appears in.  The result depends only on the
+   name, the starting block, and whether the call is a method call, so
+   it is cached under that key.
+
+   The entries for a name are dropped when a new function with that
+   name becomes visible.  Walks that see a private function are not
+   cached because the result also depends on the scope of the call, and
+   neither are walks through a renaming 'use', since their result also
+   depends on functions with the original name.
+ */
+typedef std::pair<int, bool>                          VisibleFnsKey;
+typedef std::map<VisibleFnsKey, std::vector<FnSymbol*> > VisibleFnsByBlock;
+
+static std::map<const char*, VisibleFnsByBlock>       visibleFnsCache;
+
+static int                                    nVisibleFnsCacheHits    = 0;
+static int                                    nVisibleFnsCacheMisses  = 0;
+
 
 
 /************************************* | **************************************
@@ -150,6 +173,7 @@ static void buildVisibleFunctionMap() {
         vfb->visibleFunctions.put(fn->name, fns);
       }
       fns->add(fn);
+      visibleFnsCache.erase(fn->name);
     }
   }
   nVisibleFunctions = gFnSymbols.n;
@@ -167,22 +191,72 @@ static void getVisibleFunctions(const char*           name,
                                 CallExpr*             call,
                                 BlockStmt*            block,
                                 std::set<BlockStmt*>& visited,
-                                Vec<FnSymbol*>&       visibleFns);
+                                Vec<FnSymbol*>&       visibleFns,
+                                bool&                 cacheable);
 
 void getVisibleFunctions(const char*      name,
                          CallExpr*        call,
                          Vec<FnSymbol*>&  visibleFns) {
   BlockStmt*           block    = getVisibilityScope(call);
+  bool                 isMethodCall = false;
+  bool                 cacheable    = true;
   std::set<BlockStmt*> visited;
 
-  getVisibleFunctions(name, call, block, visited, visibleFns);
+  if (call->numActuals() >= 2 && call->get(1)->typeInfo() == dtMethodToken)
+    isMethodCall = true;
+
+  VisibleFnsKey key(block->id, isMethodCall);
+
+  name = astr(name);
+
+  if (call->id != breakOnResolveID) {
+    std::map<const char*, VisibleFnsByBlock>::iterator byName;
+
+    byName = visibleFnsCache.find(name);
+
+    if (byName != visibleFnsCache.end()) {
+      VisibleFnsByBlock::iterator it = byName->second.find(key);
+
+      if (it != byName->second.end()) {
+        for_vector(FnSymbol, fn, it->second) {
+          visibleFns.add(fn);
+        }
+
+        nVisibleFnsCacheHits++;
+
+        return;
+      }
+    }
+  }
+
+  int start = visibleFns.n;
+
+  getVisibleFunctions(name, call, block, visited, visibleFns, cacheable);
+
+  nVisibleFnsCacheMisses++;
+
+  if (cacheable == true) {
+    std::vector<FnSymbol*>& entry = visibleFnsCache[name][key];
+
+    entry.clear();
+
+    for (int i = start; i < visibleFns.n; i++) {
+      entry.push_back(visibleFns.v[i]);
+    }
+  }
+}
+
+void visibleFunctionsPrintStats(FILE* fp) {
+  fprintf(fp, "visible function lookups cached: %d\n", nVisibleFnsCacheHits);
+  fprintf(fp, "visible function lookups walked: %d\n", nVisibleFnsCacheMisses);
 }
 
 static void getVisibleFunctions(const char*           name,
                                 CallExpr*             call,
                                 BlockStmt*            block,
                                 std::set<BlockStmt*>& visited,
-                                Vec<FnSymbol*>&       visibleFns) {
+                                Vec<FnSymbol*>&       visibleFns,
+                                bool&                 cacheable) {
 
   //
   // all functions in standard modules are stored in a single block
@@ -255,6 +329,10 @@ static void getVisibleFunctions(const char*           name,
 
       if (Vec<FnSymbol*>* fns = vfb->visibleFunctions.get(name)) {
         forv_Vec(FnSymbol, fn, *fns) {
+          if (fn->hasFlag(FLAG_PRIVATE) == true) {
+            cacheable = false;
+          }
+
           if (fn->isVisible(call) == true) {
             // isVisible checks if the function is private to its defining
             // module (and in that case, if we are under its defining module)
@@ -287,19 +365,27 @@ static void getVisibleFunctions(const char*           name,
             // The use statement could be of an enum instead of a module,
             // but only modules can define functions.
 
+            if (mod->hasFlag(FLAG_PRIVATE) == true) {
+              cacheable = false;
+            }
+
             if (mod->isVisible(call) == true) {
               if (use->isARename(name) == true) {
+                cacheable = false;
+
                 getVisibleFunctions(use->getRename(name),
                                     call,
                                     mod->block,
                                     visited,
-                                    visibleFns);
+                                    visibleFns,
+                                    cacheable);
               } else {
                 getVisibleFunctions(name,
                                     call,
                                     mod->block,
                                     visited,
-                                    visibleFns);
+                                    visibleFns,
+                                    cacheable);
               }
             }
           }
@@ -311,11 +397,12 @@ static void getVisibleFunctions(const char*           name,
       BlockStmt* next  = getVisibilityScope(block);
 
       // Recurse in the enclosing block
-      getVisibleFunctions(name, call, next, visited, visibleFns);
+      getVisibleFunctions(name, call, next, visited, visibleFns, cacheable);
 
       if (instantiationPt != NULL) {
         // Also look at the instantiation point
-        getVisibleFunctions(name, call, instantiationPt, visited, visibleFns);
+        getVisibleFunctions(name, call, instantiationPt, visited, visibleFns,
+                            cacheable);
       }
     }
   }
@@ -463,6 +550,8 @@ void visibleFunctionsClear() {
   }
 
   visibleFunctionMap.clear();
+
+  visibleFnsCache.clear();
 }
 
 /************************************* | **************************************
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2004-2018 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ * 
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * 
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "parallelFor.h"
+
+#include "driver.h"
+#include "misc.h"
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include <vector>
+
+struct ParallelForState {
+  ParallelForTask task;
+  void*           arg;
+  int             n;
+  int             next;
+};
+
+static void* parallelForWorker(void* data) {
+  ParallelForState* state = (ParallelForState*) data;
+
+  while (true) {
+    int i = __sync_fetch_and_add(&state->next, 1);
+
+    if (i >= state->n)
+      break;
+
+    state->task(i, state->arg);
+  }
+
+  return NULL;
+}
+
+int compilerThreads() {
+  long threads = fCompilerThreads;
+
+  if (threads <= 0)
+    threads = sysconf(_SC_NPROCESSORS_ONLN);
+
+  return threads > 1 ? (int) threads : 1;
+}
+
+void parallelFor(int n, ParallelForTask task, void* arg) {
+  ParallelForState state = { task, arg, n, 0 };
+  int              nThreads = compilerThreads();
+
+  if (nThreads > n)
+    nThreads = n;
+
+  // The calling thread is one of the workers.
+  std::vector<pthread_t> threads;
+
+  for (int t = 1; t < nThreads; t++) {
+    pthread_t thread;
+
+    if (pthread_create(&thread, NULL, parallelForWorker, &state) != 0)
+      break;
+
+    threads.push_back(thread);
+  }
+
+  parallelForWorker(&state);
+
+  for (size_t t = 0; t < threads.size(); t++) {
+    if (pthread_join(threads[t], NULL) != 0)
+      INT_FATAL("unable to join compiler worker thread");
+  }
+}
@@ -127,6 +127,37 @@ proc _computeNumChunks(numElems): int {
   return numChunks;
 }
 
+//
+// Arrange numChunks tasks as a rows x cols grid over an n1 x n2 index
+// space, choosing the factorization whose blocks are closest to square.
+// If no factorization of numChunks fits, fewer tasks are used.
+//
+proc _computeTaskGrid(numChunks: int, n1, n2): (int, int) {
+  const len1 = n1:int, len2 = n2:int;
+  var chunks = numChunks;
+
+  while chunks > 1 {
+    var best = (0, 0);
+    var bestCost = max(real);
+    for rows in 1..chunks {
+      const cols = chunks / rows;
+      if rows * cols != chunks || rows > len1 || cols > len2 then
+        continue;
+      // half the perimeter of a block
+      const cost = len1:real / rows + len2:real / cols;
+      if cost < bestCost {
+        best = (rows, cols);
+        bestCost = cost;
+      }
+    }
+    if best(1) != 0 then
+      return best;
+    chunks -= 1;
+  }
+
+  return (1, 1);
+}
+
 // Divide 1..numElems into (almost) equal numChunk pieces
 // and return myChunk-th piece.
 proc _computeChunkStartEnd(nElems, nChunks, myCnk): 2*nElems.type {
@@ -0,0 +1,286 @@
+/*
+ * Copyright 2004-2018 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//
+// Used by the compiler to aggregate remote reads in forall loops
+// (--auto-aggregation).  A forall whose body is 'B[i] = A[expr]' gets a
+// task-private chpl__SrcAggregator, and the assignment becomes a call to
+// its copy() method.  Remote reads are buffered per owning locale and
+// fetched in bulk when a buffer fills up and when the task finishes.
+// Likewise, a forall whose body is 'A[expr].add(v)', or another atomic
+// update, gets a task-private chpl__AtomicAggregator and the update
+// becomes a call to its update() method.
+//
+module ChapelAutoAggregation {
+  use ChapelLocale;
+  use CPtr;
+  use Types;
+
+  // Number of buffered reads per remote locale, per task.
+  config const chpl__aggregationBufferSize = 1024;
+
+  pragma "no doc"
+  proc chpl__srcAggregatorFor(A: []) where isPODType(A.eltType) {
+    return new chpl__SrcAggregator(A.eltType);
+  }
+
+  pragma "no doc"
+  proc chpl__srcAggregatorFor(A) {
+    return new chpl__NoAggregator();
+  }
+
+  // Stands in for an aggregator when the source is not an array of PODs.
+  // The compiler does not aggregate such assignments.
+  pragma "no doc"
+  record chpl__NoAggregator {
+  }
+
+  pragma "no doc"
+  record chpl__SrcAggregator {
+    type elemType;
+
+    // All buffers are allocated on first use, so a copy of a fresh
+    // aggregator does not share any of them.
+    var dstAddrs:   c_ptr(c_ptr(c_ptr(elemType)));
+    var srcAddrs:   c_ptr(c_ptr(c_ptr(elemType)));
+    var bufferIdxs: c_ptr(int);
+    var vals:       c_ptr(elemType);
+
+    inline proc copy(ref dst: elemType, const ref src: elemType) {
+      const loc = src.locale.id;
+
+      if loc == here.id || dst.locale.id != here.id {
+        dst = src;
+        return;
+      }
+
+      if bufferIdxs == nil then
+        allocate();
+
+      if dstAddrs[loc] == nil {
+        dstAddrs[loc] = c_malloc(c_ptr(elemType), chpl__aggregationBufferSize);
+        srcAddrs[loc] = c_malloc(c_ptr(elemType), chpl__aggregationBufferSize);
+      }
+
+      ref idx = bufferIdxs[loc];
+
+      dstAddrs[loc][idx] = __primitive("_wide_get_addr", dst):c_ptr(elemType);
+      srcAddrs[loc][idx] = __primitive("_wide_get_addr", src):c_ptr(elemType);
+      idx += 1;
+
+      if idx == chpl__aggregationBufferSize then
+        flush(loc);
+    }
+
+    proc allocate() {
+      dstAddrs   = c_calloc(c_ptr(c_ptr(elemType)), numLocales);
+      srcAddrs   = c_calloc(c_ptr(c_ptr(elemType)), numLocales);
+      bufferIdxs = c_calloc(int, numLocales);
+      vals       = c_malloc(elemType, chpl__aggregationBufferSize);
+    }
+
+    //
+    // Ship the buffered source addresses to 'loc', read the elements
+    // there, and bring the values back: one GET and one PUT under a
+    // single on-statement, instead of one GET per element.
+    //
+    proc flush(loc: int) {
+      const n = bufferIdxs[loc];
+
+      if n == 0 then
+        return;
+
+      const origin  = here.id;
+      const addrBuf = srcAddrs[loc];
+      const valBuf  = vals;
+
+      on Locales[loc] {
+        const addrs    = c_malloc(c_ptr(elemType), n);
+        const gathered = c_malloc(elemType, n);
+
+        chpl__aggregationGet(addrs, origin, addrBuf, n);
+
+        for j in 0..#n do
+          gathered[j] = addrs[j].deref();
+
+        chpl__aggregationPut(gathered, origin, valBuf, n);
+
+        c_free(gathered);
+        c_free(addrs);
+      }
+
+      const dsts = dstAddrs[loc];
+
+      for j in 0..#n do
+        dsts[j].deref() = vals[j];
+
+      bufferIdxs[loc] = 0;
+    }
+
+    proc deinit() {
+      if bufferIdxs == nil then
+        return;
+
+      for loc in 0..#numLocales {
+        if dstAddrs[loc] != nil {
+          flush(loc);
+
+          c_free(dstAddrs[loc]);
+          c_free(srcAddrs[loc]);
+        }
+      }
+
+      c_free(vals);
+      c_free(bufferIdxs);
+      c_free(srcAddrs);
+      c_free(dstAddrs);
+    }
+  }
+
+  pragma "no doc"
+  proc chpl__atomicAggregatorFor(A: [], param op: string)
+    where isAtomicType(A.eltType) && A.eltType != chpl__atomicType(bool) {
+    return new chpl__AtomicAggregator(A.eltType, op);
+  }
+
+  pragma "no doc"
+  proc chpl__atomicAggregatorFor(A, param op: string) {
+    return new chpl__NoAggregator();
+  }
+
+  //
+  // Buffers unordered updates of remote atomics, e.g. the increments of a
+  // distributed histogram, and applies them on the owning locale.  'op'
+  // names the update: "add", "sub", "or", "and" or "xor".
+  //
+  pragma "no doc"
+  record chpl__AtomicAggregator {
+    type atomicType;
+    param op: string;
+
+    // As in chpl__SrcAggregator, all buffers are allocated on first use.
+    var addrs:      c_ptr(c_ptr(c_ptr(atomicType)));
+    var operands:   c_ptr(c_ptr(atomicType.T));
+    var bufferIdxs: c_ptr(int);
+
+    inline proc update(ref a: atomicType, value: atomicType.T) {
+      const loc = a.locale.id;
+
+      if loc == here.id {
+        chpl__atomicUpdate(op, a, value);
+        return;
+      }
+
+      if bufferIdxs == nil then
+        allocate();
+
+      if addrs[loc] == nil {
+        addrs[loc]    = c_malloc(c_ptr(atomicType), chpl__aggregationBufferSize);
+        operands[loc] = c_malloc(atomicType.T, chpl__aggregationBufferSize);
+      }
+
+      ref idx = bufferIdxs[loc];
+
+      addrs[loc][idx]    = __primitive("_wide_get_addr", a):c_ptr(atomicType);
+      operands[loc][idx] = value;
+      idx += 1;
+
+      if idx == chpl__aggregationBufferSize then
+        flush(loc);
+    }
+
+    proc allocate() {
+      addrs      = c_calloc(c_ptr(c_ptr(atomicType)), numLocales);
+      operands   = c_calloc(c_ptr(atomicType.T), numLocales);
+      bufferIdxs = c_calloc(int, numLocales);
+    }
+
+    //
+    // Fetch the buffered addresses and operands from the origin and apply
+    // the updates on 'loc', where they are processor-local atomics.
+    //
+    proc flush(loc: int) {
+      const n = bufferIdxs[loc];
+
+      if n == 0 then
+        return;
+
+      const origin     = here.id;
+      const addrBuf    = addrs[loc];
+      const operandBuf = operands[loc];
+
+      on Locales[loc] {
+        const addrsHere = c_malloc(c_ptr(atomicType), n);
+        const operandsHere = c_malloc(atomicType.T, n);
+
+        chpl__aggregationGet(addrsHere, origin, addrBuf, n);
+        chpl__aggregationGet(operandsHere, origin, operandBuf, n);
+
+        for j in 0..#n do
+          chpl__atomicUpdate(op, addrsHere[j].deref(), operandsHere[j]);
+
+        c_free(operandsHere);
+        c_free(addrsHere);
+      }
+
+      bufferIdxs[loc] = 0;
+    }
+
+    proc deinit() {
+      if bufferIdxs == nil then
+        return;
+
+      for loc in 0..#numLocales {
+        if addrs[loc] != nil {
+          flush(loc);
+
+          c_free(operands[loc]);
+          c_free(addrs[loc]);
+        }
+      }
+
+      c_free(bufferIdxs);
+      c_free(operands);
+      c_free(addrs);
+    }
+  }
+
+  private inline proc chpl__atomicUpdate(param op: string, ref a, value) {
+    if op == "add" then a.add(value);
+    else if op == "sub" then a.sub(value);
+    else if op == "or" then a.or(value);
+    else if op == "and" then a.and(value);
+    else if op == "xor" then a.xor(value);
+    else compilerError("unknown atomic update: " + op);
+  }
+
+  // The pointers are passed by value so that the primitives see the
+  // addresses they hold rather than wide references to the variables.
+  private inline proc chpl__aggregationGet(dst: c_ptr, srcLoc: int,
+                                           src: c_ptr, n: int) {
+    __primitive("chpl_comm_get", dst, srcLoc, src,
+                n.safeCast(size_t) * c_sizeof(dst.eltType));
+  }
+
+  private inline proc chpl__aggregationPut(src: c_ptr, dstLoc: int,
+                                           dst: c_ptr, n: int) {
+    __primitive("chpl_comm_put", src, dstLoc, dst,
+                n.safeCast(size_t) * c_sizeof(src.eltType));
+  }
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright 2004-2018 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//
+// Used by the compiler to fuse runs of promoted whole-array statements
+// (--forall-fusion).  The fused statements run in one forall loop over
+// the domain of the first assigned array, reading the element of each
+// array operand at the loop index.
+//
+module ChapelForallFusion {
+
+  pragma "no doc"
+  proc chpl__canFuse(const ref first: []) {
+    return true;
+  }
+
+  // Whether all the arrays among 'first' and 'xs' are declared over the
+  // same domain, so that promotion pairs up the elements at each index.
+  pragma "no doc"
+  proc chpl__canFuse(const ref first: [], const ref xs...) {
+    const dom = first._value.dom: object;
+
+    for param i in 1..xs.size do
+      if isArray(xs(i)) && xs(i)._value.dom: object != dom then
+        return false;
+
+    return true;
+  }
+
+  pragma "no doc"
+  inline proc chpl__fusedElt(const ref A: [], i) const ref {
+    return A[i];
+  }
+
+  // Scalars are promoted to every element.
+  pragma "no doc"
+  inline proc chpl__fusedElt(x, i) {
+    return x;
+  }
+}
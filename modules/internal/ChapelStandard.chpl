@@ -66,6 +66,8 @@ module ChapelStandard {
   use ChapelDynDispHack;
   use ChapelTaskData;
   use ChapelSerializedBroadcast;
+  use ChapelAutoAggregation;
+  use ChapelForallFusion;
 
   // Standard modules.
   use Assert;
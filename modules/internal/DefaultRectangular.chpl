@@ -27,6 +27,20 @@ module DefaultRectangular {
   if dataParTasksPerLocale<0 then halt("dataParTasksPerLocale must be >= 0");
   if dataParMinGranularity<=0 then halt("dataParMinGranularity must be > 0");
 
+  // Tiled data parallelism for multidimensional domains.  When enabled,
+  // the leader divides the two outermost dimensions among the tasks as a
+  // 2-D grid and each task walks its block in tiles of dataParTileSize
+  // indices per dimension (dataParInnerTileSize in the innermost one),
+  // visiting the tiles in dataParTileOrder.
+  enum TileOrder { RowMajor, Morton, Hilbert }
+  config param dataParTiled = false;
+  config const dataParTileSize = 64;
+  config const dataParInnerTileSize = 64;
+  config const dataParTileOrder = TileOrder.Morton;
+
+  if dataParTileSize<=0 then halt("dataParTileSize must be > 0");
+  if dataParInnerTileSize<=0 then halt("dataParInnerTileSize must be > 0");
+
   use DSIUtil, ChapelArray;
   config param debugDefaultDist = false;
   config param debugDefaultDistBulkTransfer = false;
@@ -283,7 +297,13 @@ module DefaultRectangular {
                 "### nranges = ", ranges);
       }
 
-      if numChunks <= 1 {
+      if dataParTiled && rank > 1 {
+        for followThis in _tiledLeader(iterKind.leader, numTasks,
+                                       ignoreRunning, minIndicesPerTask,
+                                       offset) do
+          for i in these(iterKind.follower, followThis) do
+            yield i;
+      } else if numChunks <= 1 {
         for i in these_help(1) {
           yield i;
         }
@@ -432,6 +452,14 @@ module DefaultRectangular {
             }
           }
         }
+      } else if dataParTiled && rank > 1 {
+        const numTasks = if tasksPerLocale==0 then here.maxTaskPar
+                         else tasksPerLocale;
+
+        for followThis in _tiledLeader(iterKind.leader, numTasks,
+                                       ignoreRunning, minIndicesPerTask,
+                                       offset) do
+          yield followThis;
       } else {
 
         if debugDefaultDist then
@@ -492,6 +520,97 @@ module DefaultRectangular {
       }
     }
 
+    //
+    // The tiled leader (dataParTiled): the two outermost dimensions are
+    // divided among the tasks as a 2-D grid, so that a short dimension
+    // does not limit the parallelism, and each task yields its block one
+    // tile at a time.
+    //
+    iter _tiledLeader(param tag: iterKind, numTasks, ignoreRunning,
+                      minIndicesPerTask, offset)
+      where tag == iterKind.leader {
+      type EC = uint; // type for element counts
+      var numElems = 1:EC;
+      for param i in 1..rank do
+        numElems *= ranges(i).length:EC;
+
+      const numChunks = if __primitive("task_get_serial") then 1
+                        else _computeNumChunks(numTasks, ignoreRunning,
+                                               minIndicesPerTask, numElems);
+
+      var locBlock: rank*range(intIdxType);
+      for param i in 1..rank do
+        locBlock(i) = offset(i)..#(ranges(i).length);
+
+      if numChunks <= 1 {
+        for tile in _tiles(locBlock) do
+          yield tile;
+      } else {
+        const (rows, cols) = _computeTaskGrid(numChunks,
+                                              locBlock(1).length,
+                                              locBlock(2).length);
+        if debugDefaultDist then
+          chpl_debug_writeln("*** DI: tiled task grid = ", (rows, cols));
+
+        coforall chunk in 0..#rows*cols {
+          var taskBlock: rank*range(intIdxType) = locBlock;
+          const (lo1,hi1) = _computeBlock(locBlock(1).length,
+                                          rows, chunk / cols,
+                                          locBlock(1).high,
+                                          locBlock(1).low,
+                                          locBlock(1).low);
+          const (lo2,hi2) = _computeBlock(locBlock(2).length,
+                                          cols, chunk % cols,
+                                          locBlock(2).high,
+                                          locBlock(2).low,
+                                          locBlock(2).low);
+          taskBlock(1) = lo1..hi1;
+          taskBlock(2) = lo2..hi2;
+          if debugDefaultDist then
+            chpl_debug_writeln("*** DI[", chunk, "]: taskBlock = ", taskBlock);
+
+          for tile in _tiles(taskBlock) do
+            yield tile;
+        }
+      }
+    }
+
+    // Yields the tiles of 'block'.  The outer dimensions are walked in
+    // row-major order and the two innermost in dataParTileOrder.
+    iter _tiles(block: rank*range(intIdxType)) {
+      var tileSize: rank*intIdxType;
+      var numTiles: rank*int;
+      for param i in 1..rank {
+        tileSize(i) = (if i == rank then dataParInnerTileSize
+                       else dataParTileSize):intIdxType;
+        numTiles(i) = ((block(i).length + tileSize(i) - 1) / tileSize(i)):int;
+      }
+
+      proc tileRange(r, size, t: int) {
+        const lo = r.low + t:intIdxType * size;
+        return lo..min(lo + size - 1, r.high);
+      }
+
+      var numOuter = 1;
+      for param i in 1..rank-2 do
+        numOuter *= numTiles(i);
+
+      var tile = block;
+      for outer in 0..#numOuter {
+        var rest = outer;
+        for param i in 1..rank-2 by -1 {
+          tile(i) = tileRange(block(i), tileSize(i), rest % numTiles(i));
+          rest /= numTiles(i);
+        }
+        for (t1, t2) in _tileOrder(numTiles(rank-1), numTiles(rank),
+                                   dataParTileOrder) {
+          tile(rank-1) = tileRange(block(rank-1), tileSize(rank-1), t1);
+          tile(rank) = tileRange(block(rank), tileSize(rank), t2);
+          yield tile;
+        }
+      }
+    }
+
     iter these(param tag: iterKind, followThis,
                tasksPerLocale = dataParTasksPerLocale,
                ignoreRunning = dataParIgnoreRunningTasks,
@@ -737,6 +856,115 @@ module DefaultRectangular {
     return chpl__intToIdx(idxType, (...i));
   }
 
+  // helper routines for ordering the tiles of a tiled leader
+
+  //
+  // Yields the coordinates of an nt1 x nt2 grid of tiles in the given
+  // order.  The Morton and Hilbert curves cover a square grid whose side
+  // is a power of two, so a rectangular grid is covered by a sequence of
+  // such squares as wide as its shorter side.
+  //
+  iter _tileOrder(nt1: int, nt2: int, order: TileOrder) {
+    if order == TileOrder.RowMajor || nt1 <= 1 || nt2 <= 1 {
+      for t1 in 0..#nt1 do
+        for t2 in 0..#nt2 do
+          yield (t1, t2);
+    } else {
+      var side = 1;
+      while side < min(nt1, nt2) do
+        side *= 2;
+      const numSquares = (max(nt1, nt2) + side - 1) / side;
+      for square in 0..#numSquares {
+        for d in 0..#side*side {
+          var (t1, t2) = if order == TileOrder.Morton then _mortonD2XY(d)
+                         else _hilbertD2XY(side, d);
+          if nt1 <= nt2 then
+            t2 += square * side;
+          else
+            t1 += square * side;
+          if t1 < nt1 && t2 < nt2 then
+            yield (t1, t2);
+        }
+      }
+    }
+  }
+
+  // the d-th point of the Z-order curve: de-interleave the bits of d
+  proc _mortonD2XY(d: int) {
+    var x = 0, y = 0, bit = 1, rest = d;
+    while rest != 0 {
+      if rest & 1 then x |= bit;
+      if rest & 2 then y |= bit;
+      rest >>= 2;
+      bit <<= 1;
+    }
+    return (x, y);
+  }
+
+  // the d-th point of the Hilbert curve over a side x side square
+  proc _hilbertD2XY(side: int, d: int) {
+    var x = 0, y = 0, rest = d, s = 1;
+    while s < side {
+      const rx = 1 & (rest / 2),
+            ry = 1 & (rest ^ rx);
+      if ry == 0 {
+        if rx == 1 {
+          x = s - 1 - x;
+          y = s - 1 - y;
+        }
+        x <=> y;
+      }
+      x += s * rx;
+      y += s * ry;
+      rest /= 4;
+      s *= 2;
+    }
+    return (x, y);
+  }
+
+  //
+  // Strength-reduced accesses along one dimension, used by the compiler
+  // (--strength-reduction).  When all of the indices of an access
+  // A[i1, ..., k, ..., in] in a loop over k except k are loop invariant,
+  // the compiler computes a base and a stride for dimension 'dim' before
+  // the loop and turns the access into chpl__dimAccess(base, stride, k).
+  // The index passed for 'dim' itself is ignored.
+  //
+  proc chpl__dimAccessBase(const ref A: [], param dim: int, ind...) {
+    const arr = A._value;
+    var full: arr.rank*arr.idxType;
+    for param i in 1..arr.rank {
+      if i != dim then
+        full(i) = ind(i);
+    }
+    if arr.stridable then
+      full(dim) = arr.off(dim);
+    return _ddata_shift(arr.eltType, arr.theData, arr.getDataIndex(full));
+  }
+
+  // For a stridable array, the offset, the absolute stride, and the
+  // multiplier of the dimension.  Otherwise the distance between two
+  // consecutive elements along the dimension.
+  proc chpl__dimAccessStride(const ref A: [], param dim: int) {
+    const arr = A._value;
+    if arr.stridable {
+      return (chpl__idxToInt(arr.off(dim)),
+              abs(arr.str(dim)):arr.intIdxType,
+              arr.blk(dim));
+    } else {
+      var zero, one: arr.rank*arr.idxType;
+      one(dim) = 1;
+      return arr.getDataIndex(one) - arr.getDataIndex(zero);
+    }
+  }
+
+  inline proc chpl__dimAccess(base: _ddata, stride: integral, k: integral) ref
+    return base(chpl__idxToInt(k) * stride);
+
+  inline proc chpl__dimAccess(base: _ddata, stride, k: integral) ref
+    where isTuple(stride)
+    return base((chpl__idxToInt(k) - stride(1)) / stride(2) * stride(3));
+
   // TODO: should this include the ranges that represent the domain?
   record _remoteAccessData {
     type eltType;
@@ -1119,16 +1347,65 @@ module DefaultRectangular {
                ignoreRunning = dataParIgnoreRunningTasks,
                minIndicesPerTask = dataParMinGranularity)
       ref where tag == iterKind.follower {
+      proc anyStridable(rangeTuple, param i: int = 1) param
+        return if i == rangeTuple.size then rangeTuple(i).stridable
+               else rangeTuple(i).stridable || anyStridable(rangeTuple, i+1);
+
       if debugDefaultDist {
         chpl_debug_writeln("*** In defRectArr simple-dd follower iterator: ",
                            followThis);
       }
 
-      for i in dom.these(tag=iterKind.follower, followThis,
-                         tasksPerLocale,
-                         ignoreRunning,
-                         minIndicesPerTask) do
-        yield dsiAccess(i);
+      //
+      // With --vectorize, walk a multidimensional block as one counted
+      // loop over its elements.  Unlike the nested loops of the domain
+      // follower, a single loop can be inlined when this follower is
+      // zippered with others, which lets the back-end compiler vectorize
+      // the forall body.  The block is contiguous in memory whenever it
+      // spans the inner dimensions, as it does for the default leader;
+      // otherwise each element's position is computed from 'k'.
+      //
+      if chpl_vectorize && rank > 1 && !stridable &&
+         !anyStridable(followThis) &&
+         storageOrder == ArrayStorageOrder.RMO {
+        var first: rank*idxType;
+        var len: rank*intIdxType;
+        var total = 1:intIdxType;
+        var contiguous = true;
+
+        for param d in 1..rank {
+          first(d) = dom.chpl_intToIdx(dom.ranges(d)._low +
+                                       followThis(d).low:intIdxType);
+          len(d) = followThis(d).length:intIdxType;
+          total *= len(d);
+        }
+        for param d in 2..rank do
+          if blk(d-1) != len(d) * blk(d) then
+            contiguous = false;
+
+        const start = getDataIndex(first);
+
+        for k in 0:intIdxType..#total do
+          yield theData(if contiguous then start + k
+                        else start + flatBlockOffset(k, len));
+      } else {
+        for i in dom.these(tag=iterKind.follower, followThis,
+                           tasksPerLocale,
+                           ignoreRunning,
+                           minIndicesPerTask) do
+          yield dsiAccess(i);
+      }
+    }
+
+    // The distance from the start of a block with extents 'len' to its
+    // k-th element in row-major order.
+    inline proc flatBlockOffset(k: intIdxType, len: rank*intIdxType) {
+      var rem = k, offset = 0:intIdxType;
+      for param d in 1..rank by -1 {
+        offset += rem % len(d) * blk(d);
+        rem /= len(d);
+      }
+      return offset;
     }
 
     proc computeFactoredOffs() {
@@ -323,14 +323,17 @@ module ExternalArray {
     return makeArrayFromExternArray(data, value.eltType);
   }
 
+  // If _owned is true, the array frees value (with its freer) when the
+  // array is destroyed.
   pragma "no copy return"
-  proc makeArrayFromExternArray(value: chpl_external_array, type eltType) {
+  proc makeArrayFromExternArray(value: chpl_external_array, type eltType,
+                                _owned: bool = false) {
     var dom = defaultExternDist.dsiNewRectangularDom(idxType=int, inds=(0..#value.size,));
     dom._free_when_no_arrs = true;
     var arr = new unmanaged ExternArr(eltType,
                                       dom,
                                       value,
-                                      _owned=false);
+                                      _owned=_owned);
     dom.add_arr(arr, locking = false);
     return _newArray(arr);
   }
@@ -687,7 +687,10 @@ const IOHINT_NONE = 0:c_int;
 const IOHINT_RANDOM = QIO_HINT_RANDOM;
 
 /*  IOHINT_SEQUENTIAL means expect sequential access. On
-    Linux, this should double the readahead.
+    Linux, this should double the readahead. Channels that read
+    with read/pread will also ask the OS to start fetching the
+    data following their buffer, so that the next refill
+    can overlap with computation.
  */
 const IOHINT_SEQUENTIAL = QIO_HINT_SEQUENTIAL;
 
@@ -887,6 +890,7 @@ private extern proc qio_file_sync(f:qio_file_ptr_t):syserr;
 private extern proc qio_channel_end_offset_unlocked(ch:qio_channel_ptr_t):int(64);
 private extern proc qio_file_get_style(f:qio_file_ptr_t, ref style:iostyle);
 private extern proc qio_file_length(f:qio_file_ptr_t, ref len:int(64)):syserr;
+private extern proc qio_file_mmap_array(f:qio_file_ptr_t, start:int(64), num_elts:int(64), elt_size:int(64), writeable:c_int, hints:c_int, ref arr:chpl_external_array):syserr;
 
 pragma "no prototype" // FIXME
 private extern proc qio_channel_create(ref ch:qio_channel_ptr_t, file:qio_file_ptr_t, hints:c_int, readable:c_int, writeable:c_int, start:int(64), end:int(64), const ref style:iostyle):syserr;
@@ -1514,6 +1518,63 @@ proc file.length():int(64) throws {
   return len;
 }
 
+/*
+
+Map a region of a file into memory and return a 1-D array, indexed
+from 0, whose elements are stored in the file. No data is copied into
+the heap; pages of the file are read by the operating system as the
+array is accessed, so this is a way to index out-of-core datasets
+directly.
+
+The mapping is shared with the file: if ``writeable`` is true, stores
+to the array update the file, and the file is extended if the region
+extends past its end. If ``writeable`` is false, the array must not
+be modified. The region is unmapped when the array is destroyed.
+
+The hints (e.g. :const:`IOHINT_SEQUENTIAL`, :const:`IOHINT_RANDOM`
+or :const:`IOHINT_CACHED`), together with the file's hints, are passed
+to the operating system with ``madvise``.
+
+This function must be called on the locale where the file was opened.
+To work with a file in parallel on several locales, open it on each
+locale and map that locale's part of it.
+
+A SystemError will be thrown if the region could not be mapped.
+
+:arg eltType: the element type, which must be a plain-old-data type.
+:arg start: the offset in bytes from the start of the file of the first
+            element.
+:arg size: the number of elements, or -1 to map until the end of the file.
+:arg writeable: whether stores to the array are allowed.
+:arg hints: optional access hints for the mapped region.
+:returns: an array over the mapped region of the file.
+ */
+proc file.mmapArray(type eltType, start:int(64) = 0, size:int(64) = -1,
+                    writeable:bool = false, hints:c_int = IOHINT_NONE) throws {
+  if !isPODType(eltType) then
+    compilerError("mmapArray requires a plain-old-data element type");
+
+  try check();
+
+  if this.home != here then
+    throw SystemError.fromSyserr(EINVAL,
+                                 "mmapArray called on a remote file");
+
+  var num = size;
+  if num < 0 {
+    var len = try this.length();
+    num = max(0, len - start) / c_sizeof(eltType):int(64);
+  }
+
+  var data:chpl_external_array;
+  var err = qio_file_mmap_array(_file_internal, start, num,
+                                c_sizeof(eltType):int(64), writeable:c_int,
+                                hints, data);
+  if err then try ioerror(err, "in file.mmapArray", this.tryGetPath());
+
+  return makeArrayFromExternArray(data, eltType, _owned=true);
+}
+
 // these strings are here (vs in _modestring)
 // in an attempt to avoid string copies, leaks,
 // and unnecessary allocations.
@@ -51,6 +51,7 @@
 
      * :mod:`PCGRandom`
      * :mod:`NPBRandom`
+     * :mod:`PhiloxRandom`
 
    .. note::
 
@@ -75,15 +76,17 @@ module Random {
   use RandomSupport;
   use NPBRandom;
   use PCGRandom;
+  use PhiloxRandom;
 
 
   /* Select between different supported RNG algorithms.
-     See :mod:`PCGRandom` and :mod:`NPBRandom` for details on
-     these algorithms.
+     See :mod:`PCGRandom`, :mod:`NPBRandom` and :mod:`PhiloxRandom`
+     for details on these algorithms.
    */
   enum RNG {
     PCG = 1,
-    NPB = 2
+    NPB = 2,
+    Philox = 3
   }
 
   /* The default RNG. The current default is PCG - see :mod:`PCGRandom`. */
@@ -205,6 +208,8 @@ module Random {
       return new owned RandomStream(seed=seed, parSafe=parSafe, eltType=eltType);
     else if algorithm == RNG.NPB then
       return new owned NPBRandomStream(seed=seed, parSafe=parSafe, eltType=eltType);
+    else if algorithm == RNG.Philox then
+      return new owned PhiloxRandomStream(seed=seed, parSafe=parSafe, eltType=eltType);
     else
       compilerError("Unknown random number generator");
   }
@@ -2391,5 +2396,558 @@ module Random {
   } // close module NPBRandom
 
 
+  /*
+     Counter-based Philox Random Number Generator
+
+     This module provides the Philox4x32-10 random number generator from
+     `Parallel Random Numbers: As Easy as 1, 2, 3` by J. K. Salmon,
+     M. A. Moraes, R. O. Dror and D. E. Shaw (SC11). See also
+     http://www.deshawresearch.com/resources_random123.html
+
+     Philox is a counter-based RNG: the `n`-th value in a stream is a pure
+     function of the seed and `n`, computed by applying 10 rounds of a
+     keyed bijection to the counter `n-1`. There is no state carried from one
+     value to the next, so skipping to any position in the stream is free and
+     every element of an array can be filled independently. That makes
+     :proc:`PhiloxRandomStream.fillRandom` and
+     :proc:`PhiloxRandomStream.iterate` perfectly parallel and, for
+     distributed arrays, free of communication.
+
+     Each counter produces 128 random bits. One counter is used per
+     generated value, so all numeric types (including `complex(128)`) use
+     exactly one position in the stream.
+
+     :proc:`PhiloxRandomStream.shuffle` and
+     :proc:`PhiloxRandomStream.permutation` run in parallel. They
+     scatter the elements into randomly chosen buckets and then shuffle
+     each bucket independently, which produces a uniformly random
+     permutation. The number of buckets only depends on the array size,
+     so the result for a given seed does not depend on the number of tasks.
+
+     While Philox passes the BigCrush suite of TestU01, it is not suitable for
+     generating key material for encryption.
+
+     .. note::
+
+       Integers within particular bounds are computed by reducing 64
+       random bits modulo the size of the range. This has a bias of at
+       most `size/2**64`.
+
+     .. note::
+
+       The interface provided by this module is expected to change.
+
+  */
+  module PhiloxRandom {
+
+    use RandomSupport;
+
+    /*
+      Compute the Philox4x32-10 function for a counter and a key.
+
+      :arg ctr: the 128-bit counter
+      :arg key: the 64-bit key
+      :returns: 128 random bits
+     */
+    proc philox4x32_10(ctr: 4*uint(32), key: 2*uint(32)): 4*uint(32) {
+      param M0 = 0xD2511F53:uint(32),
+            M1 = 0xCD9E8D57:uint(32),
+            W0 = 0x9E3779B9:uint(32),
+            W1 = 0xBB67AE85:uint(32);
+      var c = ctr;
+      var k = key;
+      for param round in 1..10 {
+        if round > 1 {
+          k(1) += W0;
+          k(2) += W1;
+        }
+        const p0 = M0:uint(64) * c(1):uint(64),
+              p1 = M1:uint(64) * c(3):uint(64);
+        c = (((p1 >> 32):uint(32)) ^ c(2) ^ k(1), p1:uint(32),
+             ((p0 >> 32):uint(32)) ^ c(4) ^ k(2), p0:uint(32));
+      }
+      return c;
+    }
+
+    /*
+      Models a stream of pseudorandom numbers generated by the Philox
+      counter-based random number generator. See the module-level notes for
+      :mod:`PhiloxRandom` for details on the PRNG used.
+    */
+    class PhiloxRandomStream {
+      /*
+        Specifies the type of value generated by the PhiloxRandomStream.
+        All numeric types are supported: `int`, `uint`, `real`, `imag`,
+        `complex`, and `bool` types of all sizes.
+      */
+      type eltType;
+
+      /*
+        The seed value for the PRNG. It is used as the Philox key.
+      */
+      const seed: int(64);
+
+      /*
+        Indicates whether or not the PhiloxRandomStream needs to be
+        parallel-safe by default.  If multiple tasks interact with it in
+        an uncoordinated fashion, this must be set to `true`.  If it will
+        only be called from a single task, or if only one task will call
+        into it at a time, setting to `false` will reduce overhead related
+        to ensuring mutual exclusion.
+      */
+      param parSafe: bool = true;
+
+      /*
+        Creates a new stream of random numbers using the specified seed
+        and parallel safety.
+
+        :arg eltType: The element type to be generated.
+        :type eltType: `type`
+
+        :arg seed: The seed to use for the PRNG.  Defaults to
+          `currentTime` from :type:`RandomSupport.SeedGenerator`.
+          Can be any int(64) value.
+        :type seed: `int(64)`
+
+        :arg parSafe: The parallel safety setting.  Defaults to `true`.
+        :type parSafe: `bool`
+
+      */
+      proc init(type eltType,
+                seed: int(64) = SeedGenerator.currentTime,
+                param parSafe: bool = true) {
+        this.eltType = eltType;
+        this.seed = seed;
+        this.parSafe = parSafe;
+      }
+
+      pragma "no doc"
+      proc PhiloxRandomStreamPrivate_reserve(n: int(64)) {
+        if parSafe then
+          PhiloxRandomStreamPrivate_lock$ = true;
+        const start = PhiloxRandomStreamPrivate_count;
+        PhiloxRandomStreamPrivate_count += n;
+        if parSafe then
+          PhiloxRandomStreamPrivate_lock$;
+        return start;
+      }
+
+      /*
+        Returns the next value in the random stream.
+
+        Generated reals are in [0,1] - both 0.0 and 1.0 are possible values.
+        Imaginary numbers are analogously in [0i, 1i]. Complex numbers will
+        consist of a generated real and imaginary part, so 0.0+0.0i and 1.0+1.0i
+        are possible.
+
+        Generated integers cover the full value range of the integer.
+
+        :arg resultType: the type of the result. Defaults to :type:`eltType`.
+        :returns: The next value in the random stream as type `resultType`.
+       */
+      proc getNext(type resultType=eltType): resultType {
+        return philoxValue(resultType, seed,
+                           PhiloxRandomStreamPrivate_reserve(1));
+      }
+
+      /*
+        Return the next random value but within a particular range.
+        Returns a number in [`min`, `max`] (inclusive).
+       */
+      proc getNext(min: eltType, max:eltType): eltType {
+        return philoxValueBounded(eltType, seed,
+                                  PhiloxRandomStreamPrivate_reserve(1),
+                                  min, max);
+      }
+
+      /*
+        Advances/rewinds the stream to the `n`-th value in the sequence.
+        The first value is with n=1.  n must be > 0, otherwise an
+        IllegalArgumentError is thrown.
+
+        :arg n: The position in the stream to skip to.  Must be > 0.
+        :type n: `integral`
+       */
+      proc skipToNth(n: integral) throws {
+        if n <= 0 then
+          throw new IllegalArgumentError("PhiloxRandomStream.skipToNth(n) called with non-positive 'n' value " + n);
+        if parSafe then
+          PhiloxRandomStreamPrivate_lock$ = true;
+        PhiloxRandomStreamPrivate_count = n;
+        if parSafe then
+          PhiloxRandomStreamPrivate_lock$;
+      }
+
+      /*
+        Advance/rewind the stream to the `n`-th value and return it
+        (advancing the stream by one).  n must be > 0, otherwise an
+        IllegalArgumentError is thrown.  This is equivalent to
+        :proc:`skipToNth()` followed by :proc:`getNext()`.
+
+        :arg n: The position in the stream to skip to.  Must be > 0.
+        :type n: `integral`
+
+        :returns: The `n`-th value in the random stream as type :type:`eltType`.
+       */
+      proc getNth(n: integral): eltType throws {
+        if n <= 0 then
+          throw new IllegalArgumentError("PhiloxRandomStream.getNth(n) called with non-positive 'n' value " + n);
+        if parSafe then
+          PhiloxRandomStreamPrivate_lock$ = true;
+        PhiloxRandomStreamPrivate_count = n + 1;
+        if parSafe then
+          PhiloxRandomStreamPrivate_lock$;
+        return philoxValue(eltType, seed, n);
+      }
+
+      /*
+        Fill the argument array with pseudorandom values.  This method is
+        identical to the standalone :proc:`~Random.fillRandom` procedure,
+        except that it consumes random values from the
+        :class:`PhiloxRandomStream` object on which it's invoked rather
+        than creating a new stream for the purpose of the call.
+
+        :arg arr: The array to be filled
+        :type arr: [] :type:`eltType`
+      */
+      proc fillRandom(arr: [] eltType) {
+        forall (x, r) in zip(arr, iterate(arr.domain, arr.eltType)) do
+          x = r;
+      }
+
+      pragma "no doc"
+      proc fillRandom(arr: []) {
+        compilerError("PhiloxRandomStream(eltType=", eltType:string,
+                      ") can only be used to fill arrays of ", eltType:string);
+      }
+
+      /* Randomly shuffle a 1-D array in parallel. */
+      proc shuffle(arr: [?D] ?eltType) {
+        if D.rank != 1 then
+          compilerError("Shuffle requires 1-D array");
+
+        const n = D.numIndices.safeCast(int(64));
+        // The bucket pass and the per-bucket shuffles each use n values.
+        const start = PhiloxRandomStreamPrivate_reserve(2*n);
+        philoxShuffle(arr, seed, start);
+      }
+
+      /* Produce a random permutation, storing it in a 1-D array.
+         The resulting array will include each value from low..high
+         exactly once, where low and high refer to the array's domain.
+         */
+      proc permutation(arr: [] eltType) {
+        if arr.domain.rank != 1 then
+          compilerError("Permutation requires 1-D array");
+
+        forall i in arr.domain do
+          arr[i] = i;
+        shuffle(arr);
+      }
+
+      /*
+
+         Returns an iterable expression for generating `D.numIndices` random
+         numbers. The RNG state will be immediately advanced by `D.numIndices`
+         before the iterable expression yields any values.
+
+         The returned iterable expression is useful in parallel contexts,
+         including standalone and zippered iteration. The domain will determine
+         the parallelization strategy.
+
+         :arg D: a domain
+         :arg resultType: the type of number to yield
+         :return: an iterable expression yielding random `resultType` values
+
+       */
+      pragma "fn returns iterator"
+      proc iterate(D: domain, type resultType=eltType) {
+        const start = PhiloxRandomStreamPrivate_reserve(
+                        D.numIndices.safeCast(int(64)));
+        return PhiloxRandomPrivate_iterate(resultType, D, seed, start);
+      }
+
+      // Forward the leader iterator as well.
+      pragma "no doc"
+      pragma "fn returns iterator"
+      proc iterate(D: domain, type resultType=eltType, param tag)
+        where tag == iterKind.leader
+      {
+        // Note that proc iterate() for the serial case (i.e. the one above)
+        // is going to be invoked as well, so we should not be taking
+        // any actions here other than the forwarding.
+        const start = PhiloxRandomStreamPrivate_count;
+        return PhiloxRandomPrivate_iterate(resultType, D, seed, start, tag);
+      }
+
+      pragma "no doc"
+      override proc writeThis(f) {
+        f <~> "PhiloxRandomStream(eltType=";
+        f <~> eltType:string;
+        f <~> ", parSafe=";
+        f <~> parSafe;
+        f <~> ", seed=";
+        f <~> seed;
+        f <~> ")";
+      }
+
+      ///////////////////////////////////////////////////////// CLASS PRIVATE //
+      //
+      // It is the intent that once Chapel supports the notion of
+      // 'private', everything in this class declared below this line will
+      // be made private to this class.
+      //
+
+      pragma "no doc"
+      var PhiloxRandomStreamPrivate_lock$: sync bool;
+      pragma "no doc"
+      var PhiloxRandomStreamPrivate_count: int(64) = 1;
+    }
+
+
+    ////////////////////////////////////////////////////////// MODULE PRIVATE //
+    //
+    // It is the intent that once Chapel supports the notion of 'private',
+    // everything declared below this line will be made private to this
+    // module.
+    //
+
+    // returns the 128 random bits for the n-th value (n is 1-based)
+    private inline
+    proc philoxBits(seed: int(64), n: int(64)): 4*uint(32) {
+      const c = (n - 1):uint(64),
+            k = seed:uint(64);
+      return philox4x32_10((c:uint(32), (c >> 32):uint(32), 0:uint(32), 0:uint(32)),
+                           (k:uint(32), (k >> 32):uint(32)));
+    }
+
+    private inline
+    proc philoxBits64(seed: int(64), n: int(64)): uint(64) {
+      const r = philoxBits(seed, n);
+      return (r(1):uint(64) << 32) | r(2):uint(64);
+    }
+
+    // returns a random number in [0, 1]
+    // where the number is a multiple of 2**-64
+    private inline
+    proc randToReal64(x: uint(64)):real(64)
+    {
+      return ldexp(x:real(64), -64);
+    }
+    private inline
+    proc randToReal64(x: uint(64), min:real(64), max:real(64)):real(64)
+    {
+      return (max-min)*randToReal64(x) + min;
+    }
+
+    // returns a random number in [0, 1]
+    // where the number is a rounded multiple of 2**-24
+    private inline
+    proc randToReal32(x: uint(32))
+    {
+      return ldexp(x:real(32), -32);
+    }
+    private inline
+    proc randToReal32(x: uint(32), min:real(32), max:real(32)):real(32)
+    {
+      return (max-min)*randToReal32(x) + min;
+    }
+
+    // returns the n-th value of the stream as a resultType
+    private inline
+    proc philoxValue(type resultType, seed: int(64), n: int(64)) {
+      const r = philoxBits(seed, n);
+      const lo = (r(1):uint(64) << 32) | r(2):uint(64),
+            hi = (r(3):uint(64) << 32) | r(4):uint(64);
+
+      if resultType == complex(128) {
+        return (randToReal64(lo), randToReal64(hi)):complex(128);
+      } else if resultType == complex(64) {
+        return (randToReal32(r(1)), randToReal32(r(2))):complex(64);
+      } else if resultType == imag(64) {
+        return _r2i(randToReal64(lo));
+      } else if resultType == imag(32) {
+        return _r2i(randToReal32(r(1)));
+      } else if resultType == real(64) {
+        return randToReal64(lo);
+      } else if resultType == real(32) {
+        return randToReal32(r(1));
+      } else if resultType == uint(64) || resultType == int(64) {
+        return lo:resultType;
+      } else if resultType == uint(32) || resultType == int(32) {
+        return r(1):resultType;
+      } else if(resultType == uint(16) ||
+                resultType == int(16)) {
+        return (r(1) >> 16):resultType;
+      } else if(resultType == uint(8) ||
+                resultType == int(8)) {
+        return (r(1) >> 24):resultType;
+      } else if isBoolType(resultType) {
+        return (r(1) >> 31) != 0;
+      } else {
+        compilerError("PhiloxRandomStream cannot produce " +
+                      resultType:string);
+      }
+    }
+
+    // returns the n-th value of the stream as a resultType
+    // with min <= x <= max
+    private inline
+    proc philoxValueBounded(type resultType, seed: int(64), n: int(64),
+                            min, max) {
+      const r = philoxBits(seed, n);
+      const lo = (r(1):uint(64) << 32) | r(2):uint(64),
+            hi = (r(3):uint(64) << 32) | r(4):uint(64);
+
+      if resultType == complex(128) {
+        return (randToReal64(lo, min.re, max.re),
+                randToReal64(hi, min.im, max.im)):complex(128);
+      } else if resultType == complex(64) {
+        return (randToReal32(r(1), min.re, max.re),
+                randToReal32(r(2), min.im, max.im)):complex(64);
+      } else if resultType == imag(64) {
+        return _r2i(randToReal64(lo, _i2r(min), _i2r(max)));
+      } else if resultType == imag(32) {
+        return _r2i(randToReal32(r(1), _i2r(min), _i2r(max)));
+      } else if resultType == real(64) {
+        return randToReal64(lo, min, max);
+      } else if resultType == real(32) {
+        return randToReal32(r(1), min, max);
+      } else if isIntegralType(resultType) {
+        // Unsigned arithmetic gives the size of the range for signed
+        // types as well.
+        const bound = max:uint(64) - min:uint(64);
+        const offset = if bound == ~0:uint(64) then lo
+                       else lo % (bound + 1);
+        return (min:uint(64) + offset):resultType;
+      } else {
+        compilerError("bounded rand with " + resultType:string);
+      }
+    }
+
+    // Buckets for the parallel shuffle. The count only depends on the
+    // number of elements so that the result does not depend on the number
+    // of tasks.
+    private param shuffleBucketSize = 4096;
+    private param shuffleMaxBuckets = 1024;
+
+    //
+    // Shuffle a 1-D array in parallel using values start..start+2*n-1.
+    // Each element is moved to a random bucket (keeping the buckets in
+    // element order), then each bucket is Fisher-Yates shuffled.
+    //
+    private proc philoxShuffle(arr: [?D], seed: int(64), start: int(64)) {
+      const r = D.dim(1);
+      const n = D.numIndices.safeCast(int(64));
+      if n <= 1 then return;
+
+      const nBuckets = min(max(n / shuffleBucketSize, 1), shuffleMaxBuckets);
+      const nTasks = max(_computeNumChunks(n), 1);
+
+      // counts[t, b] becomes the position where task t's
+      // first element for bucket b goes.
+      var counts: [0..#nTasks, 0..#nBuckets] int(64);
+      coforall t in 0..#nTasks with (ref counts) {
+        const (lo, hi) = _computeChunkStartEnd(n, nTasks, t+1);
+        for k in lo-1..hi-1 do
+          counts[t, (philoxBits64(seed, start+k) % nBuckets:uint):int] += 1;
+      }
+
+      var bucketStart: [0..nBuckets] int(64);
+      var sum = 0:int(64);
+      for b in 0..#nBuckets {
+        bucketStart[b] = sum;
+        for t in 0..#nTasks {
+          const c = counts[t, b];
+          counts[t, b] = sum;
+          sum += c;
+        }
+      }
+      bucketStart[nBuckets] = n;
+
+      var tmp: [D] arr.eltType;
+      coforall t in 0..#nTasks with (ref counts, ref tmp) {
+        const (lo, hi) = _computeChunkStartEnd(n, nTasks, t+1);
+        for k in lo-1..hi-1 {
+          const b = (philoxBits64(seed, start+k) % nBuckets:uint):int;
+          tmp[r.orderToIndex(counts[t, b])] = arr[r.orderToIndex(k)];
+          counts[t, b] += 1;
+        }
+      }
+
+      forall b in 0..#nBuckets with (ref tmp) {
+        const bs = bucketStart[b],
+              be = bucketStart[b+1];
+        // Fisher-Yates shuffle
+        for j in bs+1..be-1 by -1 {
+          const k = bs + (philoxBits64(seed, start+n+j) %
+                          (j-bs+1):uint(64)):int(64);
+          tmp[r.orderToIndex(k)] <=> tmp[r.orderToIndex(j)];
+        }
+      }
+
+      arr = tmp;
+    }
+
+    //
+    // iterate over outer ranges in tuple of ranges
+    //
+    private iter outer(ranges, param dim: int = 1) {
+      if dim + 1 == ranges.size {
+        for i in ranges(dim) do
+          yield (i,);
+      } else if dim + 1 < ranges.size {
+        for i in ranges(dim) do
+          for j in outer(ranges, dim+1) do
+            yield (i, (...j));
+      } else {
+        yield 0; // 1D case is a noop
+      }
+    }
+
+    //
+    // PhiloxRandomStream iterator implementation
+    //
+    pragma "no doc"
+    iter PhiloxRandomPrivate_iterate(type resultType, D: domain, seed: int(64),
+                                     start: int(64)) {
+      var n = start;
+      for i in D {
+        yield philoxValue(resultType, seed, n);
+        n += 1;
+      }
+    }
+
+    pragma "no doc"
+    iter PhiloxRandomPrivate_iterate(type resultType, D: domain, seed: int(64),
+                                     start: int(64), param tag: iterKind)
+          where tag == iterKind.leader {
+      for block in D._value.these(tag=iterKind.leader) do
+        yield block;
+    }
+
+    pragma "no doc"
+    iter PhiloxRandomPrivate_iterate(type resultType, D: domain, seed: int(64),
+                 start: int(64), param tag: iterKind, followThis)
+          where tag == iterKind.follower {
+      const ZD = computeZeroBasedDomain(D);
+      const innerRange = followThis(ZD.rank);
+      for outer in outer(followThis) {
+        // Every value only depends on its position, so there is no
+        // cursor to set up; just find the position of the first index.
+        var myStart = start;
+        if ZD.rank > 1 then
+          myStart += ZD.indexOrder(((...outer), innerRange.low)).safeCast(int(64));
+        else
+          myStart += ZD.indexOrder(innerRange.low).safeCast(int(64));
+        myStart -= innerRange.low.safeCast(int(64));
+        for i in innerRange do
+          yield philoxValue(resultType, seed, myStart + i.safeCast(int(64)));
+      }
+    }
+
+  } // close module PhiloxRandom
+
+
 
 } // close module Random
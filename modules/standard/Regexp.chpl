@@ -391,6 +391,19 @@ private extern proc qio_regexp_string_piece_isnull(ref sp:qio_regexp_string_piec
 private extern proc qio_regexp_match(const ref re:qio_regexp_t, text:c_string, textlen:int(64), startpos:int(64), endpos:int(64), anchor:c_int, submatch:_ddata(qio_regexp_string_piece_t), nsubmatch:int(64)):bool;
 private extern proc qio_regexp_replace(const ref re:qio_regexp_t, repl:c_string, repllen:int(64), text:c_string, textlen:int(64), startpos:int(64), endpos:int(64), global:bool, ref replaced:c_string, ref replaced_len:int(64)):int(64);
 
+pragma "no doc"
+extern record qio_regexp_set_t {
+}
+pragma "no doc"
+extern proc qio_regexp_set_null():qio_regexp_set_t;
+private extern proc qio_regexp_set_create(const ref options:qio_regexp_options_t, anchor:c_int, ref set:qio_regexp_set_t);
+private extern proc qio_regexp_set_add(ref set:qio_regexp_set_t, str:c_string, strlen:int(64), ref error:c_string):int(64);
+private extern proc qio_regexp_set_compile(ref set:qio_regexp_set_t):bool;
+private extern proc qio_regexp_set_match(const ref set:qio_regexp_set_t, text:c_string, textlen:int(64), startpos:int(64), endpos:int(64), matches:_ddata(int(64)), nmatches:int(64)):int(64);
+private extern proc qio_regexp_set_retain(const ref set:qio_regexp_set_t);
+pragma "no doc"
+extern proc qio_regexp_set_release(ref set:qio_regexp_set_t);
+
 // These two could be folded together if we had a way
 // to check if a default argument was supplied
 // (or any way to use 'nil' in pass-by-ref)
@@ -562,7 +575,9 @@ proc string.this(m:reMatch) {
 }
 
 /*  This class represents a compiled regular expression. Regular expressions
-    are currently cached on a per-thread basis and are reference counted.
+    are currently cached on a per-thread basis, backed by a cache shared by
+    all threads, and are reference counted. Compiling the same pattern with
+    the same options again is therefore cheap.
     To create a compiled regular expression, use the compile function.
 
     A regexp can be cast to a string (resulting in the pattern that
@@ -1049,6 +1064,140 @@ inline proc _cast(type t, x: string) throws where t == regexp {
   return compile(x);
 }
 
+/*  This record represents a set of regular expressions that are
+    searched for together. Searching a text with a regexpSet makes a
+    single pass over the text no matter how many patterns are in the set,
+    so it is much faster than searching with each pattern in turn.
+
+    To create a regexpSet, use the :proc:`compileSet` function.
+  */
+pragma "ignore noinit"
+record regexpSet {
+  pragma "no doc"
+  var home: locale = here;
+  pragma "no doc"
+  var _set:qio_regexp_set_t = qio_regexp_set_null();
+  pragma "no doc"
+  var _low:int;
+  pragma "no doc"
+  var _n:int;
+
+  proc init() {
+  }
+
+  proc init(x: regexpSet) {
+    this.home = x.home;
+    this._set = x._set;
+    this._low = x._low;
+    this._n = x._n;
+    this.complete();
+    on home {
+      qio_regexp_set_retain(_set);
+    }
+  }
+
+  pragma "no doc"
+  proc ref deinit() {
+    on home do qio_regexp_set_release(_set);
+    _set = qio_regexp_set_null();
+  }
+
+  /* The number of patterns in this set */
+  proc size:int {
+    return _n;
+  }
+
+  /*
+     Search the passed text for every pattern in this set at once.
+
+     :arg text: a string to search
+     :returns: an array containing, in increasing order, the index of each
+               pattern (in the index space of the array passed to
+               :proc:`compileSet`) that matches somewhere in text
+   */
+  proc search(text: string) {
+    var D:domain(1);
+    var ret:[D] int;
+    on this.home {
+      var found = _ddata_allocate(int(64), _n);
+      var nfound = qio_regexp_set_match(_set, text.localize().c_str(),
+                                        text.length, 0, text.length,
+                                        found, _n);
+      D = {0..#nfound};
+      for i in 0..#nfound do ret[i] = found[i]:int + _low;
+      _ddata_free(found, _n);
+    }
+    return ret;
+  }
+}
+
+pragma "no doc"
+proc =(ref ret:regexpSet, x:regexpSet)
+{
+  // retain -- release
+  on x.home do qio_regexp_set_retain(x._set);
+  on ret.home do qio_regexp_set_release(ret._set);
+  ret.home = x.home;
+  ret._set = x._set;
+  ret._low = x._low;
+  ret._n = x._n;
+}
+
+/*
+   Compile several regular expressions into a :record:`regexpSet` that
+   can search a text for all of them in one pass.
+
+   :arg patterns: a 1-D array of the regular expressions to compile
+   :arg utf8: (optional, default true) set to `true` to create regular
+               expressions matching UTF-8; `false` for binary or ASCII only.
+   :arg posix: (optional) set to true to disable non-POSIX regular expression
+               syntax
+   :arg literal: (optional) set to true to treat the patterns as literals
+   :arg ignorecase: (optional) set to true in order to ignore case when
+                    matching
+   :arg multiline: (optional) set to true in order to activate multiline mode
+   :arg dotnl: (optional, default false) set to true in order to allow ``.``
+               to match a newline
+
+   :throws BadRegexpError: if a pattern does not compile
+ */
+proc compileSet(patterns: [?D] string, utf8=true, posix=false, literal=false, /*i*/ ignorecase=false, /*m*/ multiline=false, /*s*/ dotnl=false):regexpSet throws {
+
+  if CHPL_REGEXP == "none" {
+    compilerError("Cannot use Regexp with CHPL_REGEXP=none");
+  }
+  if D.rank != 1 || D.stridable {
+    compilerError("compileSet requires a 1-D array with a non-strided domain");
+  }
+
+  var opts:qio_regexp_options_t;
+  qio_regexp_init_default_options(opts);
+  opts.utf8 = utf8;
+  opts.posix = posix;
+  opts.literal = literal;
+  opts.nocapture = true;
+  opts.ignorecase = ignorecase;
+  opts.multiline = multiline;
+  opts.dotnl = dotnl;
+
+  var ret: regexpSet;
+  qio_regexp_set_create(opts, QIO_REGEXP_ANCHOR_UNANCHORED, ret._set);
+  ret._low = D.low;
+  ret._n = D.size;
+  for pattern in patterns {
+    var err_str:c_string;
+    if qio_regexp_set_add(ret._set, pattern.localize().c_str(), pattern.length,
+                          err_str) < 0 {
+      var err_msg = new string(err_str, needToCopy=false) +
+                    " when compiling regexp '" + pattern + "'";
+      throw new BadRegexpError(err_msg);
+    }
+  }
+  if !qio_regexp_set_compile(ret._set) then
+    throw new BadRegexpError("could not compile regexp set");
+  return ret;
+}
+
 
 
 /*
@@ -0,0 +1,525 @@
+/*
+ * Copyright 2004-2018 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+  Fixed-width vector types for explicit SIMD programming.
+
+  A :record:`simd` value holds `width` elements of type `eltType`, called
+  lanes, and the arithmetic and comparison operators apply to all the lanes
+  at once.  The following vector types are supported:
+
+  =============  ==============  =====
+  type alias     eltType         width
+  =============  ==============  =====
+  `real64x4`     `real(64)`      4
+  `real32x8`     `real(32)`      8
+  `int64x4`      `int(64)`       4
+  `int32x8`      `int(32)`       8
+  =============  ==============  =====
+
+  Lanes are numbered from 0.  Comparing two vectors produces a *mask*: an
+  integer vector with the same number of lanes, holding -1 in the lanes
+  where the comparison holds and 0 elsewhere.  Masks choose between the
+  lanes of two vectors with :proc:`blend`.  A vector can be created from
+  its lanes by casting a tuple, e.g. ``(1.0, 2.0, 3.0, 4.0):real64x4``.
+
+  .. code-block:: chapel
+
+    use SIMD;
+
+    var A: [0..#1024] real = ...;
+    var acc: real64x4;
+
+    for i in 0..#1024 by 4 {
+      const v = real64x4.load(A, i);
+      acc += blend(v > 0.0, v, -v);
+    }
+
+    writeln(acc.sum());
+
+  With the C back-end the vector types are mapped to GCC vector extension
+  types when the target compiler supports them (GNU, Clang, and Intel), and
+  with the LLVM back-end to LLVM vector types.  Elsewhere each operation is
+  a loop over the lanes.  Whether the operations become single vector
+  instructions depends on the instruction set the program is compiled for,
+  e.g. ``--ccflags -mavx2`` or ``--specialize``.
+ */
+module SIMD {
+
+  /*
+    A vector of `width` values of type `eltType`.  The default value has
+    all lanes set to 0.
+   */
+  record simd {
+    /* The type of each lane. */
+    type eltType;
+    /* The number of lanes. */
+    param width: int;
+
+    pragma "no doc"
+    var v = SIMD_internal.splat(SIMD_internal.vecType(eltType, width),
+                                0:eltType);
+
+    /* Return the value of lane `i`. */
+    inline proc this(i: integral): eltType {
+      if boundsChecking then
+        SIMD_internal.checkLane(i, width);
+      return SIMD_internal.extract(v, i:int);
+    }
+
+    /* Set lane `i` to `x`. */
+    inline proc ref set(i: integral, x: eltType) {
+      if boundsChecking then
+        SIMD_internal.checkLane(i, width);
+      SIMD_internal.assign(v, SIMD_internal.insert(v, i:int, x));
+    }
+
+    /* Return the sum of the lanes. */
+    inline proc sum(): eltType {
+      return SIMD_internal.reduceAdd(v);
+    }
+
+    /* Return the smallest lane. */
+    inline proc min(): eltType {
+      return SIMD_internal.reduceMin(v);
+    }
+
+    /* Return the largest lane. */
+    inline proc max(): eltType {
+      return SIMD_internal.reduceMax(v);
+    }
+
+    /*
+      Store the lanes into `A[i..#width]`.  `A` must be a local,
+      one-dimensional rectangular array with unit stride.
+     */
+    inline proc store(ref A: [] eltType, i: integral) {
+      SIMD_internal.checkArray(A, i, width);
+      SIMD_internal.store(c_ptrTo(A[i]), v);
+    }
+
+    pragma "no doc"
+    proc writeThis(f) {
+      f <~> "<";
+      for param i in 0..width-1 {
+        if i > 0 then f <~> ", ";
+        f <~> this(i);
+      }
+      f <~> ">";
+    }
+  }
+
+  /* Four 64-bit reals. */
+  type real64x4 = simd(real(64), 4);
+
+  /* Eight 32-bit reals. */
+  type real32x8 = simd(real(32), 8);
+
+  /* Four 64-bit integers, also the mask type of :type:`real64x4`. */
+  type int64x4 = simd(int(64), 4);
+
+  /* Eight 32-bit integers, also the mask type of :type:`real32x8`. */
+  type int32x8 = simd(int(32), 8);
+
+  /*
+    The type of the masks produced by comparing two vectors of type `t`.
+   */
+  proc maskType(type t: simd) type {
+    return simd(int(numBits(t.eltType)), t.width);
+  }
+
+  /* Return a vector with every lane set to `x`. */
+  inline proc type simd.splat(x: eltType) {
+    return SIMD_internal.wrap(eltType, width,
+             SIMD_internal.splat(SIMD_internal.vecType(eltType, width), x));
+  }
+
+  pragma "no doc"
+  inline proc _cast(type t: simd, x: _tuple)
+    where isHomogeneousTuple(x) && x.size == t.width {
+    var r: t;
+    for param k in 0..t.width-1 do
+      r.set(k, x(k+1):t.eltType);
+    return r;
+  }
+
+  /*
+    Return a vector holding `A[i..#width]`.  `A` must be a local,
+    one-dimensional rectangular array with unit stride.
+   */
+  inline proc type simd.load(const ref A: [] eltType, i: integral) {
+    SIMD_internal.checkArray(A, i, width);
+    return SIMD_internal.wrap(eltType, width,
+             SIMD_internal.load(SIMD_internal.vecType(eltType, width),
+                                SIMD_internal.addrOf(A[i])));
+  }
+
+  /*
+    Return a vector whose lane `k` holds `A[A.domain.low + idx(k)]`.  `A`
+    must be a local, one-dimensional rectangular array with unit stride,
+    and `idx` a vector of offsets into it with the same lane width as the
+    elements of `A`.
+   */
+  inline proc gather(const ref A: [] ?eltType, idx: simd(?t, ?w))
+    where numBits(t) == numBits(eltType) && isIntType(t) {
+    const lo = A.domain.low;
+    if boundsChecking {
+      for param k in 0..w-1 do
+        if idx(k) < 0 || idx(k) >= A.size then
+          halt("gather offset ", idx(k), " out of bounds for array of size ",
+               A.size);
+    }
+    SIMD_internal.checkArray(A, lo, 1);
+    return SIMD_internal.wrap(eltType, w,
+             SIMD_internal.gather(SIMD_internal.vecType(eltType, w),
+                                  SIMD_internal.addrOf(A[lo]), idx.v));
+  }
+
+  /*
+    Return a vector whose lanes are taken from `a` where `mask` is set and
+    from `b` elsewhere.
+   */
+  inline proc blend(mask: simd, a: simd, b: a.type)
+    where mask.type == maskType(a.type) {
+    return SIMD_internal.wrap(a.eltType, a.width,
+                              SIMD_internal.blend(mask.v, a.v, b.v));
+  }
+
+  pragma "no doc"
+  inline proc blend(mask: simd, a: simd, b: a.eltType)
+    where mask.type == maskType(a.type) {
+    return blend(mask, a, a.type.splat(b));
+  }
+
+  pragma "no doc"
+  inline proc blend(mask: simd, a, b: simd)
+    where mask.type == maskType(b.type) && !isSubtype(a.type, simd) {
+    return blend(mask, b.type.splat(a:b.eltType), b);
+  }
+
+  /* Return the lane-wise minimum of `a` and `b`. */
+  inline proc min(a: simd, b: a.type) {
+    return SIMD_internal.wrap(a.eltType, a.width,
+                              SIMD_internal.min(a.v, b.v));
+  }
+
+  /* Return the lane-wise maximum of `a` and `b`. */
+  inline proc max(a: simd, b: a.type) {
+    return SIMD_internal.wrap(a.eltType, a.width,
+                              SIMD_internal.max(a.v, b.v));
+  }
+
+  pragma "no doc"
+  inline proc =(ref a: simd, b: a.type) {
+    SIMD_internal.assign(a.v, b.v);
+  }
+
+  pragma "no doc"
+  inline proc +(a: simd, b: a.type) {
+    return SIMD_internal.wrap(a.eltType, a.width, SIMD_internal.add(a.v, b.v));
+  }
+
+  pragma "no doc"
+  inline proc -(a: simd, b: a.type) {
+    return SIMD_internal.wrap(a.eltType, a.width, SIMD_internal.sub(a.v, b.v));
+  }
+
+  pragma "no doc"
+  inline proc *(a: simd, b: a.type) {
+    return SIMD_internal.wrap(a.eltType, a.width, SIMD_internal.mul(a.v, b.v));
+  }
+
+  pragma "no doc"
+  inline proc /(a: simd, b: a.type) {
+    return SIMD_internal.wrap(a.eltType, a.width, SIMD_internal.div(a.v, b.v));
+  }
+
+  pragma "no doc"
+  inline proc -(a: simd) {
+    return a.type.splat(0:a.eltType) - a;
+  }
+
+  pragma "no doc"
+  inline proc +(a: simd) {
+    return a;
+  }
+
+  pragma "no doc"
+  inline proc <(a: simd, b: a.type) {
+    return SIMD_internal.wrap(int(numBits(a.eltType)), a.width,
+                              SIMD_internal.lt(a.v, b.v));
+  }
+
+  pragma "no doc"
+  inline proc <=(a: simd, b: a.type) {
+    return SIMD_internal.wrap(int(numBits(a.eltType)), a.width,
+                              SIMD_internal.le(a.v, b.v));
+  }
+
+  pragma "no doc"
+  inline proc >(a: simd, b: a.type) {
+    return SIMD_internal.wrap(int(numBits(a.eltType)), a.width,
+                              SIMD_internal.gt(a.v, b.v));
+  }
+
+  pragma "no doc"
+  inline proc >=(a: simd, b: a.type) {
+    return SIMD_internal.wrap(int(numBits(a.eltType)), a.width,
+                              SIMD_internal.ge(a.v, b.v));
+  }
+
+  pragma "no doc"
+  inline proc ==(a: simd, b: a.type) {
+    return SIMD_internal.wrap(int(numBits(a.eltType)), a.width,
+                              SIMD_internal.eq(a.v, b.v));
+  }
+
+  pragma "no doc"
+  inline proc !=(a: simd, b: a.type) {
+    return SIMD_internal.wrap(int(numBits(a.eltType)), a.width,
+                              SIMD_internal.ne(a.v, b.v));
+  }
+
+  //
+  // The scalar versions of the binary operators splat the scalar.
+  //
+  pragma "no doc"
+  inline proc +(a: simd, b: a.eltType) { return a + a.type.splat(b); }
+  pragma "no doc"
+  inline proc +(a, b: simd) where !isSubtype(a.type, simd) {
+    return b.type.splat(a:b.eltType) + b;
+  }
+  pragma "no doc"
+  inline proc -(a: simd, b: a.eltType) { return a - a.type.splat(b); }
+  pragma "no doc"
+  inline proc -(a, b: simd) where !isSubtype(a.type, simd) {
+    return b.type.splat(a:b.eltType) - b;
+  }
+  pragma "no doc"
+  inline proc *(a: simd, b: a.eltType) { return a * a.type.splat(b); }
+  pragma "no doc"
+  inline proc *(a, b: simd) where !isSubtype(a.type, simd) {
+    return b.type.splat(a:b.eltType) * b;
+  }
+  pragma "no doc"
+  inline proc /(a: simd, b: a.eltType) { return a / a.type.splat(b); }
+  pragma "no doc"
+  inline proc /(a, b: simd) where !isSubtype(a.type, simd) {
+    return b.type.splat(a:b.eltType) / b;
+  }
+  pragma "no doc"
+  inline proc <(a: simd, b: a.eltType) { return a < a.type.splat(b); }
+  pragma "no doc"
+  inline proc <=(a: simd, b: a.eltType) { return a <= a.type.splat(b); }
+  pragma "no doc"
+  inline proc >(a: simd, b: a.eltType) { return a > a.type.splat(b); }
+  pragma "no doc"
+  inline proc >=(a: simd, b: a.eltType) { return a >= a.type.splat(b); }
+  pragma "no doc"
+  inline proc ==(a: simd, b: a.eltType) { return a == a.type.splat(b); }
+  pragma "no doc"
+  inline proc !=(a: simd, b: a.eltType) { return a != a.type.splat(b); }
+}
+
+private module SIMD_internal {
+  use SIMD;
+
+  require "chpl-simd.h";
+
+  extern type chpl_simd_real64x4;
+  extern type chpl_simd_real32x8;
+  extern type chpl_simd_int64x4;
+  extern type chpl_simd_int32x8;
+
+  proc vecType(type eltType, param width) type {
+    if eltType == real(64) && width == 4 then
+      return chpl_simd_real64x4;
+    else if eltType == real(32) && width == 8 then
+      return chpl_simd_real32x8;
+    else if eltType == int(64) && width == 4 then
+      return chpl_simd_int64x4;
+    else if eltType == int(32) && width == 8 then
+      return chpl_simd_int32x8;
+    else
+      compilerError("simd(", eltType:string, ", ", width:string,
+                    ") is not a supported vector type");
+  }
+
+  // The assignment operators of the extern types are only visible here.
+  inline proc assign(ref lhs, rhs) {
+    lhs = rhs;
+  }
+
+  // The element address of a const array, which c_ptrTo() does not accept.
+  inline proc addrOf(const ref x) {
+    return __primitive("_wide_get_addr", x):c_ptr(x.type);
+  }
+
+  inline proc wrap(type eltType, param width, x) {
+    var r: simd(eltType, width);
+    r.v = x;
+    return r;
+  }
+
+  proc checkLane(i, param width) {
+    if i < 0 || i >= width then
+      halt("lane ", i, " out of bounds for a vector of width ", width);
+  }
+
+  proc checkArray(const ref A: [], i, param n) {
+    if A.rank != 1 || A.stridable || !A._value.isDefaultRectangular() then
+      compilerError("SIMD vectors can only be loaded from and stored to ",
+                    "one-dimensional rectangular arrays with unit stride");
+    if boundsChecking {
+      if A.locale != here then
+        halt("SIMD vectors can only be loaded from and stored to local ",
+             "arrays");
+      if !A.domain.contains(i) || !A.domain.contains(i + n - 1) then
+        halt("indices ", i, "..#", n, " out of bounds for array with ",
+             "domain ", A.domain);
+    }
+  }
+
+  //
+  // One overload per vector type and operation, named after the C
+  // functions in runtime/include/chpl-simd.h.
+  //
+  inline proc splat(type t, x) {
+    select t {
+      when chpl_simd_real64x4 do return chpl_simd_real64x4_splat(x);
+      when chpl_simd_real32x8 do return chpl_simd_real32x8_splat(x);
+      when chpl_simd_int64x4  do return chpl_simd_int64x4_splat(x);
+      when chpl_simd_int32x8  do return chpl_simd_int32x8_splat(x);
+    }
+  }
+
+  inline proc load(type t, p) {
+    select t {
+      when chpl_simd_real64x4 do return chpl_simd_real64x4_load(p);
+      when chpl_simd_real32x8 do return chpl_simd_real32x8_load(p);
+      when chpl_simd_int64x4  do return chpl_simd_int64x4_load(p);
+      when chpl_simd_int32x8  do return chpl_simd_int32x8_load(p);
+    }
+  }
+
+  inline proc gather(type t, p, idx) {
+    select t {
+      when chpl_simd_real64x4 do return chpl_simd_real64x4_gather(p, idx);
+      when chpl_simd_real32x8 do return chpl_simd_real32x8_gather(p, idx);
+      when chpl_simd_int64x4  do return chpl_simd_int64x4_gather(p, idx);
+      when chpl_simd_int32x8  do return chpl_simd_int32x8_gather(p, idx);
+    }
+  }
+
+  extern proc chpl_simd_real64x4_splat(x: real(64)): chpl_simd_real64x4;
+  extern proc chpl_simd_real64x4_load(p: c_ptr(real(64))): chpl_simd_real64x4;
+  extern proc chpl_simd_real64x4_gather(p: c_ptr(real(64)),
+                                        idx: chpl_simd_int64x4): chpl_simd_real64x4;
+  extern "chpl_simd_real64x4_store" proc store(p: c_ptr(real(64)), v: chpl_simd_real64x4);
+  extern "chpl_simd_real64x4_extract" proc extract(v: chpl_simd_real64x4, i: int): real(64);
+  extern "chpl_simd_real64x4_insert" proc insert(v: chpl_simd_real64x4, i: int, x: real(64)): chpl_simd_real64x4;
+  extern "chpl_simd_real64x4_add" proc add(a: chpl_simd_real64x4, b: chpl_simd_real64x4): chpl_simd_real64x4;
+  extern "chpl_simd_real64x4_sub" proc sub(a: chpl_simd_real64x4, b: chpl_simd_real64x4): chpl_simd_real64x4;
+  extern "chpl_simd_real64x4_mul" proc mul(a: chpl_simd_real64x4, b: chpl_simd_real64x4): chpl_simd_real64x4;
+  extern "chpl_simd_real64x4_div" proc div(a: chpl_simd_real64x4, b: chpl_simd_real64x4): chpl_simd_real64x4;
+  extern "chpl_simd_real64x4_min" proc min(a: chpl_simd_real64x4, b: chpl_simd_real64x4): chpl_simd_real64x4;
+  extern "chpl_simd_real64x4_max" proc max(a: chpl_simd_real64x4, b: chpl_simd_real64x4): chpl_simd_real64x4;
+  extern "chpl_simd_real64x4_lt" proc lt(a: chpl_simd_real64x4, b: chpl_simd_real64x4): chpl_simd_int64x4;
+  extern "chpl_simd_real64x4_le" proc le(a: chpl_simd_real64x4, b: chpl_simd_real64x4): chpl_simd_int64x4;
+  extern "chpl_simd_real64x4_gt" proc gt(a: chpl_simd_real64x4, b: chpl_simd_real64x4): chpl_simd_int64x4;
+  extern "chpl_simd_real64x4_ge" proc ge(a: chpl_simd_real64x4, b: chpl_simd_real64x4): chpl_simd_int64x4;
+  extern "chpl_simd_real64x4_eq" proc eq(a: chpl_simd_real64x4, b: chpl_simd_real64x4): chpl_simd_int64x4;
+  extern "chpl_simd_real64x4_ne" proc ne(a: chpl_simd_real64x4, b: chpl_simd_real64x4): chpl_simd_int64x4;
+  extern "chpl_simd_real64x4_blend" proc blend(m: chpl_simd_int64x4, a: chpl_simd_real64x4, b: chpl_simd_real64x4): chpl_simd_real64x4;
+  extern "chpl_simd_real64x4_reduce_add" proc reduceAdd(v: chpl_simd_real64x4): real(64);
+  extern "chpl_simd_real64x4_reduce_min" proc reduceMin(v: chpl_simd_real64x4): real(64);
+  extern "chpl_simd_real64x4_reduce_max" proc reduceMax(v: chpl_simd_real64x4): real(64);
+
+  extern proc chpl_simd_real32x8_splat(x: real(32)): chpl_simd_real32x8;
+  extern proc chpl_simd_real32x8_load(p: c_ptr(real(32))): chpl_simd_real32x8;
+  extern proc chpl_simd_real32x8_gather(p: c_ptr(real(32)),
+                                        idx: chpl_simd_int32x8): chpl_simd_real32x8;
+  extern "chpl_simd_real32x8_store" proc store(p: c_ptr(real(32)), v: chpl_simd_real32x8);
+  extern "chpl_simd_real32x8_extract" proc extract(v: chpl_simd_real32x8, i: int): real(32);
+  extern "chpl_simd_real32x8_insert" proc insert(v: chpl_simd_real32x8, i: int, x: real(32)): chpl_simd_real32x8;
+  extern "chpl_simd_real32x8_add" proc add(a: chpl_simd_real32x8, b: chpl_simd_real32x8): chpl_simd_real32x8;
+  extern "chpl_simd_real32x8_sub" proc sub(a: chpl_simd_real32x8, b: chpl_simd_real32x8): chpl_simd_real32x8;
+  extern "chpl_simd_real32x8_mul" proc mul(a: chpl_simd_real32x8, b: chpl_simd_real32x8): chpl_simd_real32x8;
+  extern "chpl_simd_real32x8_div" proc div(a: chpl_simd_real32x8, b: chpl_simd_real32x8): chpl_simd_real32x8;
+  extern "chpl_simd_real32x8_min" proc min(a: chpl_simd_real32x8, b: chpl_simd_real32x8): chpl_simd_real32x8;
+  extern "chpl_simd_real32x8_max" proc max(a: chpl_simd_real32x8, b: chpl_simd_real32x8): chpl_simd_real32x8;
+  extern "chpl_simd_real32x8_lt" proc lt(a: chpl_simd_real32x8, b: chpl_simd_real32x8): chpl_simd_int32x8;
+  extern "chpl_simd_real32x8_le" proc le(a: chpl_simd_real32x8, b: chpl_simd_real32x8): chpl_simd_int32x8;
+  extern "chpl_simd_real32x8_gt" proc gt(a: chpl_simd_real32x8, b: chpl_simd_real32x8): chpl_simd_int32x8;
+  extern "chpl_simd_real32x8_ge" proc ge(a: chpl_simd_real32x8, b: chpl_simd_real32x8): chpl_simd_int32x8;
+  extern "chpl_simd_real32x8_eq" proc eq(a: chpl_simd_real32x8, b: chpl_simd_real32x8): chpl_simd_int32x8;
+  extern "chpl_simd_real32x8_ne" proc ne(a: chpl_simd_real32x8, b: chpl_simd_real32x8): chpl_simd_int32x8;
+  extern "chpl_simd_real32x8_blend" proc blend(m: chpl_simd_int32x8, a: chpl_simd_real32x8, b: chpl_simd_real32x8): chpl_simd_real32x8;
+  extern "chpl_simd_real32x8_reduce_add" proc reduceAdd(v: chpl_simd_real32x8): real(32);
+  extern "chpl_simd_real32x8_reduce_min" proc reduceMin(v: chpl_simd_real32x8): real(32);
+  extern "chpl_simd_real32x8_reduce_max" proc reduceMax(v: chpl_simd_real32x8): real(32);
+
+  extern proc chpl_simd_int64x4_splat(x: int(64)): chpl_simd_int64x4;
+  extern proc chpl_simd_int64x4_load(p: c_ptr(int(64))): chpl_simd_int64x4;
+  extern proc chpl_simd_int64x4_gather(p: c_ptr(int(64)),
+                                       idx: chpl_simd_int64x4): chpl_simd_int64x4;
+  extern "chpl_simd_int64x4_store" proc store(p: c_ptr(int(64)), v: chpl_simd_int64x4);
+  extern "chpl_simd_int64x4_extract" proc extract(v: chpl_simd_int64x4, i: int): int(64);
+  extern "chpl_simd_int64x4_insert" proc insert(v: chpl_simd_int64x4, i: int, x: int(64)): chpl_simd_int64x4;
+  extern "chpl_simd_int64x4_add" proc add(a: chpl_simd_int64x4, b: chpl_simd_int64x4): chpl_simd_int64x4;
+  extern "chpl_simd_int64x4_sub" proc sub(a: chpl_simd_int64x4, b: chpl_simd_int64x4): chpl_simd_int64x4;
+  extern "chpl_simd_int64x4_mul" proc mul(a: chpl_simd_int64x4, b: chpl_simd_int64x4): chpl_simd_int64x4;
+  extern "chpl_simd_int64x4_div" proc div(a: chpl_simd_int64x4, b: chpl_simd_int64x4): chpl_simd_int64x4;
+  extern "chpl_simd_int64x4_min" proc min(a: chpl_simd_int64x4, b: chpl_simd_int64x4): chpl_simd_int64x4;
+  extern "chpl_simd_int64x4_max" proc max(a: chpl_simd_int64x4, b: chpl_simd_int64x4): chpl_simd_int64x4;
+  extern "chpl_simd_int64x4_lt" proc lt(a: chpl_simd_int64x4, b: chpl_simd_int64x4): chpl_simd_int64x4;
+  extern "chpl_simd_int64x4_le" proc le(a: chpl_simd_int64x4, b: chpl_simd_int64x4): chpl_simd_int64x4;
+  extern "chpl_simd_int64x4_gt" proc gt(a: chpl_simd_int64x4, b: chpl_simd_int64x4): chpl_simd_int64x4;
+  extern "chpl_simd_int64x4_ge" proc ge(a: chpl_simd_int64x4, b: chpl_simd_int64x4): chpl_simd_int64x4;
+  extern "chpl_simd_int64x4_eq" proc eq(a: chpl_simd_int64x4, b: chpl_simd_int64x4): chpl_simd_int64x4;
+  extern "chpl_simd_int64x4_ne" proc ne(a: chpl_simd_int64x4, b: chpl_simd_int64x4): chpl_simd_int64x4;
+  extern "chpl_simd_int64x4_blend" proc blend(m: chpl_simd_int64x4, a: chpl_simd_int64x4, b: chpl_simd_int64x4): chpl_simd_int64x4;
+  extern "chpl_simd_int64x4_reduce_add" proc reduceAdd(v: chpl_simd_int64x4): int(64);
+  extern "chpl_simd_int64x4_reduce_min" proc reduceMin(v: chpl_simd_int64x4): int(64);
+  extern "chpl_simd_int64x4_reduce_max" proc reduceMax(v: chpl_simd_int64x4): int(64);
+
+  extern proc chpl_simd_int32x8_splat(x: int(32)): chpl_simd_int32x8;
+  extern proc chpl_simd_int32x8_load(p: c_ptr(int(32))): chpl_simd_int32x8;
+  extern proc chpl_simd_int32x8_gather(p: c_ptr(int(32)),
+                                       idx: chpl_simd_int32x8): chpl_simd_int32x8;
+  extern "chpl_simd_int32x8_store" proc store(p: c_ptr(int(32)), v: chpl_simd_int32x8);
+  extern "chpl_simd_int32x8_extract" proc extract(v: chpl_simd_int32x8, i: int): int(32);
+  extern "chpl_simd_int32x8_insert" proc insert(v: chpl_simd_int32x8, i: int, x: int(32)): chpl_simd_int32x8;
+  extern "chpl_simd_int32x8_add" proc add(a: chpl_simd_int32x8, b: chpl_simd_int32x8): chpl_simd_int32x8;
+  extern "chpl_simd_int32x8_sub" proc sub(a: chpl_simd_int32x8, b: chpl_simd_int32x8): chpl_simd_int32x8;
+  extern "chpl_simd_int32x8_mul" proc mul(a: chpl_simd_int32x8, b: chpl_simd_int32x8): chpl_simd_int32x8;
+  extern "chpl_simd_int32x8_div" proc div(a: chpl_simd_int32x8, b: chpl_simd_int32x8): chpl_simd_int32x8;
+  extern "chpl_simd_int32x8_min" proc min(a: chpl_simd_int32x8, b: chpl_simd_int32x8): chpl_simd_int32x8;
+  extern "chpl_simd_int32x8_max" proc max(a: chpl_simd_int32x8, b: chpl_simd_int32x8): chpl_simd_int32x8;
+  extern "chpl_simd_int32x8_lt" proc lt(a: chpl_simd_int32x8, b: chpl_simd_int32x8): chpl_simd_int32x8;
+  extern "chpl_simd_int32x8_le" proc le(a: chpl_simd_int32x8, b: chpl_simd_int32x8): chpl_simd_int32x8;
+  extern "chpl_simd_int32x8_gt" proc gt(a: chpl_simd_int32x8, b: chpl_simd_int32x8): chpl_simd_int32x8;
+  extern "chpl_simd_int32x8_ge" proc ge(a: chpl_simd_int32x8, b: chpl_simd_int32x8): chpl_simd_int32x8;
+  extern "chpl_simd_int32x8_eq" proc eq(a: chpl_simd_int32x8, b: chpl_simd_int32x8): chpl_simd_int32x8;
+  extern "chpl_simd_int32x8_ne" proc ne(a: chpl_simd_int32x8, b: chpl_simd_int32x8): chpl_simd_int32x8;
+  extern "chpl_simd_int32x8_blend" proc blend(m: chpl_simd_int32x8, a: chpl_simd_int32x8, b: chpl_simd_int32x8): chpl_simd_int32x8;
+  extern "chpl_simd_int32x8_reduce_add" proc reduceAdd(v: chpl_simd_int32x8): int(32);
+  extern "chpl_simd_int32x8_reduce_min" proc reduceMin(v: chpl_simd_int32x8): int(32);
+  extern "chpl_simd_int32x8_reduce_max" proc reduceMax(v: chpl_simd_int32x8): int(32);
+}
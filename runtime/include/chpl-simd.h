@@ -0,0 +1,209 @@
+/*
+ * Copyright 2004-2018 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Fixed-width vector types and operations for the SIMD module.
+//
+// With compilers that support GCC vector extensions (gcc, clang, and intel)
+// the lanes of a vector are a vector_size type, which clang lowers to an
+// LLVM vector type, and the element-wise operations are the native vector
+// operators.  Elsewhere, and when compiling with -DCHPL_SIMD_SCALAR, the
+// lanes are an array and every operation loops over them.
+//
+// A comparison yields a mask: a vector of signed integers of the same lane
+// width, with every bit set in the lanes where the comparison holds.  The
+// vector types are only aligned like their elements, so that they can live
+// anywhere in memory, e.g. in arrays of records.
+
+#ifndef _chpl_simd_h_
+#define _chpl_simd_h_
+
+#include <stdint.h>
+#include <string.h>
+
+#include "chpl-comp-detect-macros.h"
+
+#if !defined(CHPL_SIMD_SCALAR) &&                                            \
+    (RT_COMP_CC & (RT_COMP_GCC | RT_COMP_CLANG | RT_COMP_INTEL))
+#define CHPL_SIMD_VECTOR_EXTENSIONS
+#endif
+
+// Each vector type is a struct holding its lanes.  Wrapping a vector_size
+// type in a struct keeps it from being passed in AVX registers, which gcc
+// warns about at every call when compiling without AVX.
+#ifdef CHPL_SIMD_VECTOR_EXTENSIONS
+
+#define CHPL_SIMD_TYPEDEF(T, ELT, W)                                         \
+  typedef ELT T##_vec __attribute__((vector_size(sizeof(ELT) * W),           \
+                                     aligned(sizeof(ELT))));                 \
+  typedef struct { T##_vec lanes; } T;
+
+#define CHPL_SIMD_BINARY(T, M, W, NAME, OP)                                  \
+  static inline T T##_##NAME(T a, T b) {                                     \
+    T r;                                                                     \
+    r.lanes = a.lanes OP b.lanes;                                            \
+    return r;                                                                \
+  }
+
+#define CHPL_SIMD_COMPARE(T, M, W, NAME, OP)                                 \
+  static inline M T##_##NAME(T a, T b) {                                     \
+    M r;                                                                     \
+    r.lanes = (M##_vec)(a.lanes OP b.lanes);                                 \
+    return r;                                                                \
+  }
+
+#define CHPL_SIMD_BLEND(T, M, W)                                             \
+  static inline T T##_blend(M m, T a, T b) {                                 \
+    T r;                                                                     \
+    r.lanes = (T##_vec)(((M##_vec)a.lanes & m.lanes) |                       \
+                        ((M##_vec)b.lanes & ~m.lanes));                      \
+    return r;                                                                \
+  }
+
+#else
+
+#define CHPL_SIMD_TYPEDEF(T, ELT, W)                                         \
+  typedef struct { ELT lanes[W]; } T;
+
+#define CHPL_SIMD_BINARY(T, M, W, NAME, OP)                                  \
+  static inline T T##_##NAME(T a, T b) {                                     \
+    T r;                                                                     \
+    int i;                                                                   \
+    for (i = 0; i < W; i++)                                                  \
+      r.lanes[i] = a.lanes[i] OP b.lanes[i];                                 \
+    return r;                                                                \
+  }
+
+#define CHPL_SIMD_COMPARE(T, M, W, NAME, OP)                                 \
+  static inline M T##_##NAME(T a, T b) {                                     \
+    M r;                                                                     \
+    int i;                                                                   \
+    for (i = 0; i < W; i++)                                                  \
+      r.lanes[i] = (a.lanes[i] OP b.lanes[i]) ? -1 : 0;                      \
+    return r;                                                                \
+  }
+
+#define CHPL_SIMD_BLEND(T, M, W)                                             \
+  static inline T T##_blend(M m, T a, T b) {                                 \
+    T r;                                                                     \
+    int i;                                                                   \
+    for (i = 0; i < W; i++)                                                  \
+      r.lanes[i] = m.lanes[i] ? a.lanes[i] : b.lanes[i];                     \
+    return r;                                                                \
+  }
+
+#endif
+
+//
+// The operations on vector type T with W lanes of type ELT and mask type M.
+// Lanes are numbered from 0.
+//
+#define CHPL_SIMD_OPS(T, ELT, M, W)                                          \
+  static inline T T##_splat(ELT x) {                                         \
+    T r;                                                                     \
+    int i;                                                                   \
+    for (i = 0; i < W; i++)                                                  \
+      r.lanes[i] = x;                                                        \
+    return r;                                                                \
+  }                                                                          \
+                                                                             \
+  static inline T T##_load(const ELT* p) {                                   \
+    T r;                                                                     \
+    memcpy(&r, p, sizeof(T));                                                \
+    return r;                                                                \
+  }                                                                          \
+                                                                             \
+  static inline void T##_store(ELT* p, T v) {                                \
+    memcpy(p, &v, sizeof(T));                                                \
+  }                                                                          \
+                                                                             \
+  static inline ELT T##_extract(T v, int64_t i) {                            \
+    return v.lanes[i];                                                       \
+  }                                                                          \
+                                                                             \
+  static inline T T##_insert(T v, int64_t i, ELT x) {                        \
+    v.lanes[i] = x;                                                          \
+    return v;                                                                \
+  }                                                                          \
+                                                                             \
+  CHPL_SIMD_BINARY(T, M, W, add, +)                                          \
+  CHPL_SIMD_BINARY(T, M, W, sub, -)                                          \
+  CHPL_SIMD_BINARY(T, M, W, mul, *)                                          \
+  CHPL_SIMD_BINARY(T, M, W, div, /)                                          \
+                                                                             \
+  CHPL_SIMD_COMPARE(T, M, W, lt, <)                                          \
+  CHPL_SIMD_COMPARE(T, M, W, le, <=)                                         \
+  CHPL_SIMD_COMPARE(T, M, W, gt, >)                                          \
+  CHPL_SIMD_COMPARE(T, M, W, ge, >=)                                         \
+  CHPL_SIMD_COMPARE(T, M, W, eq, ==)                                         \
+  CHPL_SIMD_COMPARE(T, M, W, ne, !=)                                         \
+                                                                             \
+  CHPL_SIMD_BLEND(T, M, W)                                                   \
+                                                                             \
+  static inline T T##_min(T a, T b) {                                        \
+    return T##_blend(T##_lt(a, b), a, b);                                    \
+  }                                                                          \
+                                                                             \
+  static inline T T##_max(T a, T b) {                                        \
+    return T##_blend(T##_gt(a, b), a, b);                                    \
+  }                                                                          \
+                                                                             \
+  static inline T T##_gather(const ELT* base, M idx) {                       \
+    T r;                                                                     \
+    int i;                                                                   \
+    for (i = 0; i < W; i++)                                                  \
+      r.lanes[i] = base[idx.lanes[i]];                                       \
+    return r;                                                                \
+  }                                                                          \
+                                                                             \
+  static inline ELT T##_reduce_add(T v) {                                    \
+    ELT r = v.lanes[0];                                                      \
+    int i;                                                                   \
+    for (i = 1; i < W; i++)                                                  \
+      r += v.lanes[i];                                                       \
+    return r;                                                                \
+  }                                                                          \
+                                                                             \
+  static inline ELT T##_reduce_min(T v) {                                    \
+    ELT r = v.lanes[0];                                                      \
+    int i;                                                                   \
+    for (i = 1; i < W; i++)                                                  \
+      if (v.lanes[i] < r) r = v.lanes[i];                                    \
+    return r;                                                                \
+  }                                                                          \
+                                                                             \
+  static inline ELT T##_reduce_max(T v) {                                    \
+    ELT r = v.lanes[0];                                                      \
+    int i;                                                                   \
+    for (i = 1; i < W; i++)                                                  \
+      if (v.lanes[i] > r) r = v.lanes[i];                                    \
+    return r;                                                                \
+  }
+
+// The integer vectors double as the masks of the floating point ones.
+CHPL_SIMD_TYPEDEF(chpl_simd_int64x4, int64_t, 4)
+CHPL_SIMD_TYPEDEF(chpl_simd_int32x8, int32_t, 8)
+CHPL_SIMD_TYPEDEF(chpl_simd_real64x4, double, 4)
+CHPL_SIMD_TYPEDEF(chpl_simd_real32x8, float, 8)
+
+CHPL_SIMD_OPS(chpl_simd_int64x4, int64_t, chpl_simd_int64x4, 4)
+CHPL_SIMD_OPS(chpl_simd_int32x8, int32_t, chpl_simd_int32x8, 8)
+CHPL_SIMD_OPS(chpl_simd_real64x4, double, chpl_simd_int64x4, 4)
+CHPL_SIMD_OPS(chpl_simd_real32x8, float, chpl_simd_int32x8, 8)
+
+#endif
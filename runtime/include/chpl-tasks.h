@@ -222,7 +222,9 @@ c_sublocid_t chpl_task_getRequestedSubloc(void);
 //
 // Get ID.
 //
+#ifndef CHPL_TASK_GETID_IMPL_DECL
 chpl_taskID_t chpl_task_getId(void);
+#endif
 
 //
 // Checks whether two task IDs are the same
@@ -203,13 +203,18 @@ typedef qio_fdflag_t fdflag_t;
 
 
 // make a re-entrant lock.
+// The owner word is also the lock itself: a task acquires the lock
+// by swapping its task ID in for NULL_OWNER. Channels are usually used
+// by a single task, so the common case is one compare-and-swap to lock
+// and one store to unlock, rather than a trip through the tasking
+// layer's sync variable implementation.
 typedef struct {
-  chpl_sync_aux_t sv;
-  chpl_taskID_t owner; // task ID of owner.
+  atomic_uint_least64_t owner; // task ID of owner, or NULL_OWNER.
   uint64_t count; // how many times owner has locked.
 } qio_lock_t;
 
 #define NULL_OWNER chpl_nullTaskID
+#define QIO_LOCK_OWNER(id) ((uint_least64_t) (id))
 
 #ifdef __cplusplus
 extern "C" {
@@ -219,14 +224,13 @@ qioerr qio_lock(qio_lock_t* x);
 void qio_unlock(qio_lock_t* x);
 
 static inline qioerr qio_lock_init(qio_lock_t* x) {
-  x->owner = NULL_OWNER;
+  atomic_init_uint_least64_t(&x->owner, QIO_LOCK_OWNER(NULL_OWNER));
   x->count = 0;
-  chpl_sync_initAux(&x->sv);
   return 0;
 }
 
 static inline void qio_lock_destroy(qio_lock_t* x) {
-  chpl_sync_destroyAux(&x->sv);
+  atomic_destroy_uint_least64_t(&x->owner);
 }
 
 #ifdef __cplusplus
@@ -287,6 +291,7 @@ static inline void qio_lock_destroy(qio_lock_t* x) { int rc = pthread_mutex_dest
 extern ssize_t qio_too_small_for_default_mmap;
 extern ssize_t qio_too_large_for_default_mmap;
 extern ssize_t qio_mmap_chunk_iobufs;
+extern ssize_t qio_readahead_iobufs;
 
 #ifdef __cplusplus
 extern "C" {
@@ -638,6 +643,18 @@ void qio_file_get_style(qio_file_t* f, qio_style_t* style)
 // Calls fflush on a FILE* first.
 qioerr qio_file_length(qio_file_t* f, int64_t *len_out);
 
+#ifdef _chplrt_H_
+#include "chpl-external-array.h"
+
+// Map num_elts elements of elt_size bytes, starting at byte offset
+// start in the file, into memory and return them as an external array
+// that unmaps the region when it is freed. The mapping is shared, so
+// stores to a writeable mapping update the file; a writeable mapping
+// extends the file if necessary. hints are added to the file's hints
+// and used to madvise the mapping.
+qioerr qio_file_mmap_array(qio_file_t* f, int64_t start, int64_t num_elts, int64_t elt_size, int writeable, qio_hint_t hints, chpl_external_array* arr_out);
+#endif
+
 /* CHANNELS ..... */
 
 /* A Read and Write Buffered channels support:
@@ -810,6 +827,10 @@ typedef struct qio_channel_s {
 
   int64_t av_end;
 
+  // When reading sequentially with read/pread, the OS has been asked
+  // to prefetch the file up to this position (see qio_readahead_iobufs).
+  int64_t readahead_end;
+
   qbuffer_t buf;
 
   // For reading/writing bits (ie less than a byte) at a time
@@ -129,6 +129,35 @@ qio_bool qio_regexp_match(qio_regexp_t* regexp, const char* str, int64_t str_len
 int64_t qio_regexp_replace(qio_regexp_t* regexp, const char* repl, int64_t repl_len, const char* str, int64_t str_len, int64_t startpos, int64_t endpos, qio_bool global, const char** str_out, int64_t* len_out);
 
 
+// A set of regular expressions, all compiled with the same options,
+// that are matched against a text at once (see RE2::Set).
+typedef struct qio_regexp_set_s {
+  void* set;
+} qio_regexp_set_t;
+
+static inline
+qio_regexp_set_t qio_regexp_set_null(void)
+{
+  qio_regexp_set_t ret;
+  ret.set = NULL;
+  return ret;
+}
+
+void qio_regexp_set_create(const qio_regexp_options_t* options, int anchor, qio_regexp_set_t* set);
+// Adds a pattern to a set that has not been compiled yet. Returns the
+// index of the pattern, which starts at 0 and increases with each call,
+// or -1 with an error string in *error_out that must be freed by the
+// caller (and was made with qio_malloc()).
+int64_t qio_regexp_set_add(qio_regexp_set_t* set, const char* str, int64_t str_len, const char** error_out);
+// Returns true if the set compiled successfully.
+qio_bool qio_regexp_set_compile(qio_regexp_set_t* set);
+// Matches text[startpos..endpos) against every pattern in a compiled set.
+// Stores the indices of up to nmatches matching patterns, in increasing
+// order, in matches and returns the total number of patterns that matched.
+int64_t qio_regexp_set_match(const qio_regexp_set_t* set, const char* text, int64_t text_len, int64_t startpos, int64_t endpos, int64_t* matches, int64_t nmatches);
+void qio_regexp_set_retain(const qio_regexp_set_t* set);
+void qio_regexp_set_release(qio_regexp_set_t* set);
+
 // Returns ENOERR if we matched, EFORMAT if we did not, or an IO error.
 // Must have a mark already set.
 // If can_discard is set,  we revert/advance/mark to 'discard'.
@@ -24,6 +24,7 @@
 
 #include "chpl-tasks-prvdata.h"
 #include "chpl-threads.h"
+#include "error.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -137,6 +138,85 @@ int chpl_task_supportsRemoteCache(void) {
   return 1;
 }
 
+
+//
+// Task pool entries and the per-thread data that points at the task a
+// thread is running.  These are defined here, rather than privately in
+// tasks-fifo.c, so that the accessors for the running task's ID and
+// private data below can be inlined into generated code.
+//
+typedef struct chpl_fifo_task_pool_struct* chpl_fifo_task_pool_p;
+
+typedef struct {
+  chpl_task_prvData_t prvdata;
+} chpl_task_prvDataImpl_t;
+
+typedef struct chpl_fifo_task_pool_struct {
+  chpl_fifo_task_pool_p* p_list_head;  // task list we're on, if any
+  chpl_fifo_task_pool_p  list_next;    // double-link pointers for list
+  chpl_fifo_task_pool_p  list_prev;
+  chpl_fifo_task_pool_p  next;         // double-link pointers for pool
+  chpl_fifo_task_pool_p  prev;
+
+  chpl_task_prvDataImpl_t chpl_data;
+
+  chpl_task_bundle_t bundle; // ends in a variable-length array
+} chpl_fifo_task_pool_t;
+
+typedef struct {
+  chpl_fifo_task_pool_p ptask;
+  struct lockReport*    lockRprt;
+} chpl_fifo_thread_private_data_t;
+
+static inline
+chpl_fifo_thread_private_data_t* chpl_fifo_get_thread_private_data(void) {
+  chpl_fifo_thread_private_data_t* tp;
+
+  tp = (chpl_fifo_thread_private_data_t*) chpl_thread_getPrivateData();
+
+  if (tp == NULL)
+    chpl_internal_error("no thread private data");
+
+  return tp;
+}
+
+
+#ifdef CHPL_TASK_GETID_IMPL_DECL
+#error "CHPL_TASK_GETID_IMPL_DECL is already defined!"
+#else
+#define CHPL_TASK_GETID_IMPL_DECL 1
+#endif
+static inline
+chpl_taskID_t chpl_task_getId(void) {
+  chpl_fifo_task_pool_p ptask = chpl_fifo_get_thread_private_data()->ptask;
+  if (ptask)
+    return ptask->bundle.id;
+  else
+    return (chpl_taskID_t) -1;
+}
+
+
+#ifdef CHPL_TASK_GET_PRVDATA_IMPL_DECL
+#error "CHPL_TASK_GET_PRVDATA_IMPL_DECL is already defined!"
+#else
+#define CHPL_TASK_GET_PRVDATA_IMPL_DECL 1
+#endif
+static inline
+chpl_task_prvData_t* chpl_task_getPrvData(void) {
+  return &chpl_fifo_get_thread_private_data()->ptask->chpl_data.prvdata;
+}
+
+
+#ifdef CHPL_TASK_GET_PRVBUNDLE_IMPL_DECL
+#error "CHPL_TASK_GET_PRVBUNDLE_IMPL_DECL is already defined!"
+#else
+#define CHPL_TASK_GET_PRVBUNDLE_IMPL_DECL 1
+#endif
+static inline
+chpl_task_bundle_t* chpl_task_getPrvBundle(void) {
+  return &chpl_fifo_get_thread_private_data()->ptask->bundle;
+}
+
 #ifdef __cplusplus
 } // end extern "C"
 #endif
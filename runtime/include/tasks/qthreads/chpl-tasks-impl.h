@@ -163,6 +163,29 @@ static inline chpl_task_bundle_t* chpl_task_getPrvBundle(void)
 }
 
 
+// Assigns the task its ID the first time one is asked for.
+chpl_taskID_t chpl_qthread_new_task_id(chpl_task_bundle_t* bundle);
+
+// Returns '(unsigned int)-1' if called outside of the tasking layer.
+#ifdef CHPL_TASK_GETID_IMPL_DECL
+#error "CHPL_TASK_GETID_IMPL_DECL is already defined!"
+#else
+#define CHPL_TASK_GETID_IMPL_DECL 1
+#endif
+static inline chpl_taskID_t chpl_task_getId(void)
+{
+    chpl_qthread_tls_t * data = chpl_qthread_get_tasklocal();
+
+    if (data == NULL)
+        return (chpl_taskID_t) -1;
+
+    if (data->bundle->id == chpl_nullTaskID)
+        return chpl_qthread_new_task_id(data->bundle);
+
+    return data->bundle->id;
+}
+
+
 //
 // Sublocale support
 //
@@ -87,6 +87,10 @@
 // when rounding up to 4k pages.
 ssize_t qio_too_small_for_default_mmap = 16*1024;
 ssize_t qio_mmap_chunk_iobufs = 128; // mmap 128 iobufs at a time (8M)
+// Channels reading with read/pread and the sequential hint ask the OS
+// to start fetching this many iobufs past what they have buffered (256k).
+// Set to 0 to disable read-ahead.
+ssize_t qio_readahead_iobufs = 4;
 
 // Future - possibly set this based on ulimit?
 ssize_t qio_initial_mmap_max = 8*1024*1024;
@@ -95,31 +99,38 @@ bool qio_allow_default_mmap = true;
 #ifdef _chplrt_H_
 qioerr qio_lock(qio_lock_t* x) {
   // recursive mutex based on glibc pthreads implementation
-  chpl_taskID_t id = chpl_task_getId();
+  uint_least64_t id = QIO_LOCK_OWNER(chpl_task_getId());
+  uint_least64_t null_owner = QIO_LOCK_OWNER(NULL_OWNER);
 
-  assert( ! chpl_task_idEquals(id, NULL_OWNER) );
+  assert( id != null_owner );
 
-  // check whether we already hold the mutex.
-  if( chpl_task_idEquals(x->owner, id) ) {
+  // check whether we already hold the mutex. Only this task
+  // could have stored its own ID, so a relaxed load is enough.
+  if( atomic_load_explicit_uint_least64_t(&x->owner,
+                                          memory_order_relaxed) == id ) {
     // just bump the counter.
     ++x->count;
     return 0;
   }
 
-  // we have to get the mutex.
-  chpl_sync_lock(&x->sv);
+  // we have to get the mutex. The uncontended case is a single
+  // compare-and-swap; otherwise let other tasks run until the
+  // owner releases it.
+  while( ! atomic_compare_exchange_weak_explicit_uint_least64_t(
+                &x->owner, null_owner, id, memory_order_acquire) ) {
+    chpl_task_yield();
+  }
 
-  assert( chpl_task_idEquals(x->owner, NULL_OWNER) );
   x->count = 1;
-  x->owner = id;
 
   return 0;
 }
 void qio_unlock(qio_lock_t* x) {
-  chpl_taskID_t id = chpl_task_getId();
+  uint_least64_t id = QIO_LOCK_OWNER(chpl_task_getId());
 
   // recursive mutex based on glibc pthreads implementation
-  if( ! chpl_task_idEquals(x->owner, id) ) {
+  if( atomic_load_explicit_uint_least64_t(&x->owner,
+                                          memory_order_relaxed) != id ) {
     abort();
   }
 
@@ -128,8 +139,8 @@ void qio_unlock(qio_lock_t* x) {
     return;
   }
 
-  x->owner = NULL_OWNER;
-  chpl_sync_unlock(&x->sv);
+  atomic_store_explicit_uint_least64_t(&x->owner, QIO_LOCK_OWNER(NULL_OWNER),
+                                       memory_order_release);
 }
 #endif
 
@@ -1433,6 +1444,118 @@ qioerr qio_file_length(qio_file_t* f, int64_t *len_out)
   return err;
 }
 
+#ifdef _chplrt_H_
+// External arrays are freed with just a pointer to their elements,
+// so qio_file_mmap_array reserves a page in front of the file mapping
+// to store the total length of the mapping.
+static
+void qio_free_mmap_array(void* elts)
+{
+  uintptr_t pagesize = sys_page_size();
+  uintptr_t data = ((uintptr_t) elts) & ~(pagesize - 1);
+  int64_t* header = (int64_t*) (data - pagesize);
+
+  sys_munmap(header, *header);
+}
+
+qioerr qio_file_mmap_array(qio_file_t* f, int64_t start, int64_t num_elts, int64_t elt_size, int writeable, qio_hint_t hints, chpl_external_array* arr_out)
+{
+  int64_t pagesize = sys_page_size();
+  int64_t nbytes;
+  int64_t map_start;
+  int64_t map_len;
+  int64_t skip;
+  int64_t file_len;
+  int prot;
+  void* header;
+  void* data;
+  qioerr err;
+
+  if( start < 0 || num_elts < 0 || elt_size <= 0 ) {
+    QIO_RETURN_CONSTANT_ERROR(EINVAL, "invalid region to map");
+  }
+  if( f->fd == -1 || f->buf || f->fsfns ) {
+    QIO_RETURN_CONSTANT_ERROR(ENOSYS, "file does not support mmap");
+  }
+  if( ! (f->fdflags & QIO_FDFLAG_READABLE) ) {
+    QIO_RETURN_CONSTANT_ERROR(EBADF, "not readable");
+  }
+  if( writeable && ! (f->fdflags & QIO_FDFLAG_WRITEABLE) ) {
+    QIO_RETURN_CONSTANT_ERROR(EBADF, "not writeable");
+  }
+  if( num_elts > (INT64_MAX - start) / elt_size ) {
+    QIO_RETURN_CONSTANT_ERROR(EOVERFLOW, "overflow in mmap");
+  }
+
+  if( num_elts == 0 ) {
+    *arr_out = chpl_make_external_array_ptr(NULL, 0);
+    return 0;
+  }
+
+  nbytes = num_elts * elt_size;
+  map_start = start - (start % pagesize);
+  skip = start - map_start;
+  map_len = skip + nbytes;
+
+  // This check is (only) important for 32-bit systems.
+  if( map_len > SSIZE_MAX - pagesize ) {
+    QIO_RETURN_CONSTANT_ERROR(EOVERFLOW, "overflow in mmap");
+  }
+
+  err = qio_file_length(f, &file_len);
+  if( err ) return err;
+
+  if( start + nbytes > file_len ) {
+    if( ! writeable ) {
+      QIO_RETURN_CONSTANT_ERROR(EINVAL, "mapped region extends past end of file");
+    }
+    // Extend the file; see _buffered_get_mmap.
+#ifdef __linux__
+    err = qio_int_to_err(sys_posix_fallocate(f->fd, map_start, map_len));
+    if( err ) return err;
+#else
+    {
+      uint8_t zero = 0;
+      ssize_t wrote = 0;
+      err = qio_int_to_err(sys_pwrite(f->fd, &zero, 1, start + nbytes - 1, &wrote));
+      if( err ) return err;
+    }
+#endif
+  }
+
+  // Reserve the header page and the region, then map the file
+  // over the region.
+  err = qio_int_to_err(sys_mmap(NULL, pagesize + map_len,
+                                PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS,
+                                -1, 0, &header));
+  if( err ) return err;
+
+  prot = PROT_READ;
+  if( writeable ) prot |= PROT_WRITE;
+
+  err = qio_int_to_err(sys_mmap(qio_ptr_add(header, pagesize), map_len,
+                                prot, MAP_SHARED|MAP_FIXED,
+                                f->fd, map_start, &data));
+  if( err ) {
+    sys_munmap(header, pagesize + map_len);
+    return err;
+  }
+
+  *(int64_t*) header = pagesize + map_len;
+
+  err = qio_madvise_for_hints(data, map_len, f->hints | hints);
+  if( err ) {
+    sys_munmap(header, pagesize + map_len);
+    return err;
+  }
+
+  *arr_out = chpl_make_external_array_ptr(qio_ptr_add(data, skip), num_elts);
+  arr_out->freer = qio_free_mmap_array;
+
+  return 0;
+}
+#endif
+
 /* CHANNELS ----------------------------- */
 static
 qioerr _qio_channel_init(qio_channel_t* ch, qio_chtype_t type)
@@ -2289,6 +2412,44 @@ qioerr _buffered_get_mmap(qio_channel_t* ch, int64_t amt_in, int writing)
   else return 0;
 }
 
+// Asks the OS to asynchronously start reading the region just past
+// what the channel has buffered, so that the next refill finds the
+// data in the page cache instead of waiting for the device. This only
+// initiates I/O; it does not block the calling task. Each region is
+// only requested once, and we never read ahead past end_pos.
+static
+void _buffered_start_readahead(qio_channel_t* ch)
+{
+#ifdef POSIX_FADV_WILLNEED
+  int64_t window;
+  int64_t start;
+  int64_t end;
+
+  if( qio_readahead_iobufs <= 0 ) return;
+  if( ! (ch->hints & QIO_HINT_SEQUENTIAL) ) return;
+  if( ch->hints & QIO_HINT_DIRECT ) return; // O_DIRECT bypasses the cache
+  if( ch->file->fsfns || ch->file->fd < 0 ) return;
+
+  window = qio_readahead_iobufs * qbytes_iobuf_size;
+
+  start = ch->av_end;
+  if( start < ch->readahead_end ) start = ch->readahead_end;
+
+  // Only issue a new request once at least half a window has been
+  // consumed, so that we make a few large requests instead of one
+  // per refill.
+  if( start - ch->av_end > window / 2 ) return;
+
+  end = ch->av_end + window;
+  if( end > ch->end_pos ) end = ch->end_pos;
+  if( end <= start ) return;
+
+  // Errors are ignored; this is only advice.
+  sys_posix_fadvise(ch->file->fd, start, end - start, POSIX_FADV_WILLNEED);
+  ch->readahead_end = end;
+#endif
+}
+
 // Runs read or pread, whichever is appropriate,
 // to read into the buffer.
 static
@@ -2365,6 +2526,10 @@ qioerr _buffered_read_atleast(qio_channel_t* ch, int64_t amt)
 
   if( err ) return err;
 
+  if( method == QIO_METHOD_READWRITE || method == QIO_METHOD_PREADPWRITE ) {
+    _buffered_start_readahead(ch);
+  }
+
   if( return_eof ) return QIO_EEOF;
   else return 0;
 }
@@ -84,6 +84,35 @@ int64_t qio_regexp_replace(qio_regexp_t* regexp, const char* repl, int64_t repl_
   return 0;
 }
 
+void qio_regexp_set_create(const qio_regexp_options_t* options, int anchor, qio_regexp_set_t* set)
+{
+  chpl_internal_error("No Regexp Support");
+}
+
+int64_t qio_regexp_set_add(qio_regexp_set_t* set, const char* str, int64_t str_len, const char** error_out)
+{
+  chpl_internal_error("No Regexp Support");
+  return -1;
+}
+
+qio_bool qio_regexp_set_compile(qio_regexp_set_t* set)
+{
+  return false;
+}
+
+int64_t qio_regexp_set_match(const qio_regexp_set_t* set, const char* text, int64_t text_len, int64_t startpos, int64_t endpos, int64_t* matches, int64_t nmatches)
+{
+  chpl_internal_error("No Regexp Support");
+  return 0;
+}
+
+void qio_regexp_set_retain(const qio_regexp_set_t* set)
+{
+}
+void qio_regexp_set_release(qio_regexp_set_t* set)
+{
+}
+
 qioerr qio_regexp_channel_match(const qio_regexp_t* regexp, const int threadsafe, struct qio_channel_s* ch, int64_t maxlen, int anchor, qio_bool can_discard, qio_bool keep_unmatched, qio_bool keep_whole_pattern, qio_regexp_string_piece_t* submatch, int64_t nsubmatch)
 {
   chpl_internal_error("No Regexp Support");
@@ -22,6 +22,7 @@
 #define CHPL_RE2
 #endif
 
+#include <algorithm>
 #include <limits>
 #include <pthread.h>
 
@@ -36,6 +37,10 @@
   #undef printf
 
 #include "re2/re2.h"
+#include "re2/set.h"
+
+#include <string>
+#include <vector>
 
 using namespace re2;
 
@@ -55,6 +60,17 @@ struct re_t {
   }
 };
 
+// RE2::Sets are shared and ref-counted like re_t.
+struct re_set_t {
+  RE2::Set set;
+  qbytes_refcnt_t ref_cnt;
+  re_set_t(const RE2::Options& options, RE2::Anchor anchor)
+    : set(options, anchor)
+  {
+    DO_INIT_REFCNT(this);
+  }
+};
+
 // A very simple 8-element local regexp cache.
 #define REGEXP_CACHE_SIZE 8
 struct cache_elem {
@@ -146,46 +162,95 @@ void re_free(re_t* re)
 }
 
 
+// A process-wide cache behind the per-thread caches. Tasks can run on
+// any thread, so without it every thread would compile its own copy
+// of a pattern. It is only consulted when the local cache misses.
+#define REGEXP_SHARED_CACHE_SIZE 64
+struct shared_re_cache {
+  pthread_mutex_t lock;
+  int64_t date;
+  cache_elem elems[REGEXP_SHARED_CACHE_SIZE];
+};
+static shared_re_cache shared_cache = { PTHREAD_MUTEX_INITIALIZER };
+
+// Returns the element of elems matching the pattern and options
+// (making its date current) or NULL. Sets *oldest to the index of the
+// least recently used element.
 static
-re_t* local_cache_get(const char* str, int64_t str_len, const qio_regexp_options_t* options) {
-  re_cache* c = local_cache();
-  int oldest;
+re_t* cache_find(cache_elem* elems, int nelems, int64_t date, const char* str, int64_t str_len, const qio_regexp_options_t* options, int* oldest) {
   int64_t oldest_date;
-  c->date++;
   // Find either the oldest element
   // or a matching element
-  oldest = 0;
-  oldest_date = c->elems[0].date;
-  for( int i = 0; i < REGEXP_CACHE_SIZE; i++ ) {
-    if( c->elems[i].date < oldest_date ) {
-      oldest = i;
-      oldest_date = c->elems[i].date;
+  *oldest = 0;
+  oldest_date = elems[0].date;
+  for( int i = 0; i < nelems; i++ ) {
+    if( elems[i].date < oldest_date ) {
+      *oldest = i;
+      oldest_date = elems[i].date;
     }
-    if( ! c->elems[i].re ) continue;
-    const string& pat = c->elems[i].re->re.pattern();
-    const RE2::Options& opt = c->elems[i].re->re.options();
+    if( ! elems[i].re ) continue;
+    const string& pat = elems[i].re->re.pattern();
+    const RE2::Options& opt = elems[i].re->re.options();
     if( (uint64_t) pat.length() == (uint64_t) str_len &&
         0 == memcmp(pat.data(), str, str_len ) &&
         equal_options(&opt, options) ) {
       // Make the date current.
-      c->elems[i].date = c->date;
-      // Return this element.
-      re_t* re = c->elems[i].re;
-      // We increment the reference count before returning a copy to the
-      // caller.  It is up to the caller to release the re_t handle when done.
-      DO_RETAIN(re);
-      return re;
+      elems[i].date = date;
+      return elems[i].re;
     }
   }
+  return NULL;
+}
+
+// Returns a re_t with a reference held for the caller, compiling it
+// and adding it to the shared cache if necessary.
+static
+re_t* shared_cache_get(const char* str, int64_t str_len, const qio_regexp_options_t* options) {
+  shared_re_cache* c = &shared_cache;
+  int oldest;
+  re_t* re;
+
+  pthread_mutex_lock(&c->lock);
+  c->date++;
+  re = cache_find(c->elems, REGEXP_SHARED_CACHE_SIZE, c->date,
+                  str, str_len, options, &oldest);
+  if( ! re ) {
+    // If we found no match, replace oldest.
+    if( c->elems[oldest].re) DO_RELEASE(c->elems[oldest].re, re_free);
+
+    // Put a new RE in that slot.
+    RE2::Options opts;
+    qio_re_options_to_re2_options(options, &opts);
+    StringPiece strp(str, str_len);
+    re = new re_t(strp, opts, NULL);
+    c->elems[oldest].date = c->date;
+    c->elems[oldest].re = re;
+  }
+  DO_RETAIN(re);
+  pthread_mutex_unlock(&c->lock);
+  return re;
+}
+
+static
+re_t* local_cache_get(const char* str, int64_t str_len, const qio_regexp_options_t* options) {
+  re_cache* c = local_cache();
+  int oldest;
+  c->date++;
+  re_t* re = cache_find(c->elems, REGEXP_CACHE_SIZE, c->date,
+                        str, str_len, options, &oldest);
+  if( re ) {
+    // We increment the reference count before returning a copy to the
+    // caller.  It is up to the caller to release the re_t handle when done.
+    DO_RETAIN(re);
+    return re;
+  }
 
   // If we found no match, replace oldest.
   if( c->elems[oldest].re) DO_RELEASE(c->elems[oldest].re, re_free);
 
-  // Put a new RE in that slot.
-  RE2::Options opts;
-  qio_re_options_to_re2_options(options, &opts);
-  StringPiece strp(str, str_len);
-  re_t* re = new re_t(strp, opts, c);
+  // Put the shared RE in that slot. The reference returned by
+  // shared_cache_get is the one held by this cache.
+  re = shared_cache_get(str, str_len, options);
   c->elems[oldest].date = c->date;
   c->elems[oldest].re = re;
   // We increment the reference count before returning a copy to the
@@ -364,6 +429,78 @@ int64_t qio_regexp_replace(qio_regexp_t* regexp, const char* repl, int64_t repl_
   return ret;
 }
 
+void qio_regexp_set_create(const qio_regexp_options_t* options, int anchor, qio_regexp_set_t* set)
+{
+  RE2::Options opts;
+  RE2::Anchor ranchor = RE2::UNANCHORED;
+
+  qio_re_options_to_re2_options(options, &opts);
+  // Errors are returned by qio_regexp_set_add instead.
+  opts.set_log_errors(false);
+
+  if( anchor == QIO_REGEXP_ANCHOR_UNANCHORED ) ranchor = RE2::UNANCHORED;
+  else if( anchor == QIO_REGEXP_ANCHOR_START ) ranchor = RE2::ANCHOR_START;
+  else if( anchor == QIO_REGEXP_ANCHOR_BOTH ) ranchor = RE2::ANCHOR_BOTH;
+
+  set->set = (void*) new re_set_t(opts, ranchor);
+}
+
+int64_t qio_regexp_set_add(qio_regexp_set_t* set, const char* str, int64_t str_len, const char** error_out)
+{
+  RE2::Set* s = &((re_set_t*) set->set)->set;
+  StringPiece strp(str, str_len);
+  std::string error;
+  int ret;
+
+  *error_out = NULL;
+  ret = s->Add(strp, &error);
+  if( ret < 0 ) *error_out = qio_strdup(error.c_str());
+  return ret;
+}
+
+qio_bool qio_regexp_set_compile(qio_regexp_set_t* set)
+{
+  RE2::Set* s = &((re_set_t*) set->set)->set;
+  return s->Compile();
+}
+
+int64_t qio_regexp_set_match(const qio_regexp_set_t* set, const char* text, int64_t text_len, int64_t startpos, int64_t endpos, int64_t* matches, int64_t nmatches)
+{
+  RE2::Set* s = &((re_set_t*) set->set)->set;
+  StringPiece textp(text + startpos, endpos - startpos);
+  std::vector<int> v;
+  int64_t i;
+
+  if( ! set->set ) return 0;
+  if( ! s->Match(textp, &v) ) return 0;
+
+  // RE2::Set does not report matches in pattern order.
+  std::sort(v.begin(), v.end());
+  for( i = 0; i < nmatches && i < (int64_t) v.size(); i++ ) {
+    matches[i] = v[i];
+  }
+  return v.size();
+}
+
+static
+void re_set_free(re_set_t* s)
+{
+  delete s;
+}
+
+void qio_regexp_set_retain(const qio_regexp_set_t* set)
+{
+  re_set_t* s = (re_set_t*) set->set;
+  DO_RETAIN(s);
+}
+
+void qio_regexp_set_release(qio_regexp_set_t* set)
+{
+  re_set_t* s = (re_set_t*) set->set;
+  DO_RELEASE(s, re_set_free);
+  set->set = NULL;
+}
+
 int qio_regexp_channel_read_byte(qio_channel_s* ch);
 void qio_regexp_channel_discard(qio_channel_s* ch, int64_t cur, int64_t min);
 
@@ -46,25 +46,10 @@
 
 
 //
-// task pool: linked list of tasks
+// task pool: linked list of tasks (defined in chpl-tasks-impl.h)
 //
-typedef struct task_pool_struct* task_pool_p;
-
-typedef struct {
-  chpl_task_prvData_t prvdata;
-} chpl_task_prvDataImpl_t;
-
-typedef struct task_pool_struct {
-  task_pool_p*     p_list_head;  // task list we're on, if any
-  task_pool_p      list_next;    // double-link pointers for list
-  task_pool_p      list_prev;
-  task_pool_p      next;         // double-link pointers for pool
-  task_pool_p      prev;
-
-  chpl_task_prvDataImpl_t chpl_data;
-
-  chpl_task_bundle_t bundle; // ends in a variable-length array
-} task_pool_t;
+typedef chpl_fifo_task_pool_p task_pool_p;
+typedef chpl_fifo_task_pool_t task_pool_t;
 
 
 typedef struct lockReport {
@@ -77,10 +62,7 @@ typedef struct lockReport {
 
 
 // This is the data that is private to each thread.
-typedef struct {
-  task_pool_p   ptask;
-  lockReport_t* lockRprt;
-} thread_private_data_t;
+typedef chpl_fifo_thread_private_data_t thread_private_data_t;
 
 
 static chpl_bool        initialized = false;
@@ -762,14 +744,6 @@ void chpl_task_startMovedTask(chpl_fn_int_t  fid, chpl_fn_p fp,
 //
 
 
-chpl_taskID_t chpl_task_getId(void) {
-  task_pool_p ptask = get_current_ptask();
-  if (ptask)
-    return ptask->bundle.id;
-  else
-    return (chpl_taskID_t) -1;
-}
-
 chpl_bool chpl_task_idEquals(chpl_taskID_t id1, chpl_taskID_t id2) {
   return id1 == id2;
 }
@@ -833,14 +807,6 @@ c_sublocid_t chpl_task_getNumSublocales(void) {
   return 0;
 }
 
-chpl_task_prvData_t* chpl_task_getPrvData(void) {
-  return & get_current_ptask()->chpl_data.prvdata;
-}
-
-chpl_task_bundle_t* chpl_task_getPrvBundle(void) {
-  return & get_current_ptask()->bundle;
-}
-
 
 size_t chpl_task_getCallStackSize(void) {
   return chpl_thread_getCallStackSize();
@@ -894,14 +860,7 @@ static chpl_taskID_t get_next_task_id(void) {
 // Get the the thread private data pointer for my thread.
 //
 static thread_private_data_t* get_thread_private_data(void) {
-  thread_private_data_t* tp;
-
-  tp = (thread_private_data_t*) chpl_thread_getPrivateData();
-
-  if (tp == NULL)
-    chpl_internal_error("no thread private data");
-
-  return tp;
+  return chpl_fifo_get_thread_private_data();
 }
 
 
@@ -922,23 +922,14 @@ void chpl_task_startMovedTask(chpl_fn_int_t       fid,
 //
 
 
-// Returns '(unsigned int)-1' if called outside of the tasking layer.
-chpl_taskID_t chpl_task_getId(void)
+// chpl_task_getId() is in chpl-tasks-impl.h; this is its slow path.
+chpl_taskID_t chpl_qthread_new_task_id(chpl_task_bundle_t* bundle)
 {
-    chpl_qthread_tls_t *tls = chpl_qthread_get_tasklocal();
-    chpl_taskID_t *id_ptr = NULL;
-
     PROFILE_INCR(profile_task_getId,1);
 
-    if (tls == NULL)
-        return (chpl_taskID_t) -1;
-
-    id_ptr = &tls->bundle->id;
-
-    if (*id_ptr == chpl_nullTaskID)
-        *id_ptr = qthread_incr(&next_task_id, 1);
+    bundle->id = qthread_incr(&next_task_id, 1);
 
-    return *id_ptr;
+    return bundle->id;
 }
 
 chpl_bool chpl_task_idEquals(chpl_taskID_t id1, chpl_taskID_t id2) {
@@ -0,0 +1,54 @@
+use IO;
+
+config const path = "mmap-array.bin";
+config const n = 10000;
+
+{
+  var f = open(path, iomode.cw);
+  var w = f.writer(kind=iokind.native, locking=false);
+  for i in 0..#n do w.write(i);
+  w.close();
+  f.close();
+}
+
+// map the whole file read-only
+{
+  var f = open(path, iomode.r);
+  var A = f.mmapArray(int, hints=IOHINT_SEQUENTIAL);
+  writeln(A.size == n);
+  writeln(+ reduce A == n*(n-1)/2);
+  writeln(A[0], " ", A[n-1]);
+}
+
+// map a region starting partway into a page and update it
+{
+  var f = open(path, iomode.rw);
+  var B = f.mmapArray(int, start=8*100, size=10, writeable=true);
+  writeln(B);
+  forall b in B do b = -b;
+}
+
+// check the update through a channel, and extend the file
+{
+  var f = open(path, iomode.rw);
+  var r = f.reader(kind=iokind.native, start=8*100, end=8*110);
+  var x:int;
+  var sum = 0;
+  while r.read(x) do sum += x;
+  writeln(sum);
+  r.close();
+
+  var C = f.mmapArray(int, start=8*n, size=5, writeable=true);
+  C = 7;
+  writeln(f.length() == 8*(n+5));
+}
+
+// mapping past the end of the file read-only is an error
+{
+  var f = open(path, iomode.r);
+  try {
+    var D = f.mmapArray(int, start=8*n, size=100);
+  } catch e {
+    writeln("caught error");
+  }
+}
@@ -0,0 +1,57 @@
+use IO, Time;
+
+// Sequential scan of a file with pread-based channels, with and without
+// the sequential hint (which enables read-ahead). Each element does
+// a little computation so that read-ahead can overlap I/O with compute.
+
+config const path = "sequential-scan.bin";
+config const n = 1024*1024;
+config const work = 10;
+config const timing = false;
+
+const preadHints = QIO_METHOD_PREADPWRITE:c_int;
+
+{
+  var f = open(path, iomode.cw);
+  var w = f.writer(kind=iokind.native, locking=false);
+  for i in 1..n do w.write(i);
+  w.close();
+  f.close();
+}
+
+proc scanFile(hints:c_int) {
+  var f = open(path, iomode.r, hints=hints);
+  var r = f.reader(kind=iokind.native, locking=false);
+  var x:int;
+  var sum = 0;
+  while r.read(x) {
+    var y = x;
+    for 1..work do y = (y * 3 + 1) % 1000003;
+    sum += x + y - y;
+  }
+  r.close();
+  f.close();
+  return sum;
+}
+
+var t1, t2: Timer;
+
+t1.start();
+const sum1 = scanFile(preadHints);
+t1.stop();
+
+t2.start();
+const sum2 = scanFile(preadHints | IOHINT_SEQUENTIAL);
+t2.stop();
+
+const expect = n*(n+1)/2;
+if sum1 == expect && sum2 == expect then
+  writeln("Success");
+else
+  writeln("Did not get expected sum ", expect, " but got ", sum1, " ", sum2);
+
+if timing {
+  writeln("n=", n, " work=", work);
+  writeln("without read-ahead: ", t1.elapsed());
+  writeln("with read-ahead: ", t2.elapsed());
+}
@@ -0,0 +1,38 @@
+use IO, Time;
+
+// Measures the overhead of channel locking when writing many small
+// values to a channel that is only used by one task.
+
+config const n = 100000;
+config const timing = false;
+
+proc writeAll(param locking:bool) {
+  var f = openmem();
+  var w = f.writer(locking=locking);
+  for i in 1..n do w.writeln(i);
+  w.close();
+  const size = f.length();
+  f.close();
+  return size;
+}
+
+var t1, t2: Timer;
+
+t1.start();
+const size1 = writeAll(locking=true);
+t1.stop();
+
+t2.start();
+const size2 = writeAll(locking=false);
+t2.stop();
+
+if size1 == size2 then
+  writeln("Success");
+else
+  writeln("Size mismatch ", size1, " ", size2);
+
+if timing {
+  writeln("n=", n);
+  writeln("locking ", t1.elapsed());
+  writeln("no locking ", t2.elapsed());
+}
@@ -0,0 +1,40 @@
+use Random, Time;
+
+config const n = 1000000;
+config const trials = 3;
+config const timing = false;
+
+proc fillGBs(param algorithm) {
+  var A: [1..n] real;
+  var t: Timer;
+  var best = max(real);
+  for trial in 1..trials {
+    t.clear();
+    t.start();
+    fillRandom(A, seed=314159, algorithm=algorithm);
+    t.stop();
+    best = min(best, t.elapsed());
+  }
+  const avg = (+ reduce A) / n;
+  if abs(avg - 0.5) > 0.01 then
+    writeln("Bad average ", avg);
+  return (n * numBytes(real)) / best / 1e9;
+}
+
+const pcg = fillGBs(RNG.PCG);
+const philox = fillGBs(RNG.Philox);
+
+var P: [1..n] int;
+var t: Timer;
+t.start();
+permutation(P, seed=314159, algorithm=RNG.Philox);
+t.stop();
+const shuffleTime = t.elapsed();
+
+if timing {
+  writeln("PCG fill GB/s: ", pcg);
+  writeln("Philox fill GB/s: ", philox);
+  writeln("Philox permutation time: ", shuffleTime);
+}
+
+writeln("Success");
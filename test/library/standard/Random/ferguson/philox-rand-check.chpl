@@ -0,0 +1,88 @@
+use Random;
+
+config const n = 100000;
+
+writeln("Checking Philox4x32-10 known answers");
+{
+  // These are from the Random123 known-answer tests
+  const M = max(uint(32));
+  assert(philox4x32_10((0:uint(32), 0:uint(32), 0:uint(32), 0:uint(32)),
+                       (0:uint(32), 0:uint(32))) ==
+         (0x6627e8d5:uint(32), 0xe169c58d:uint(32),
+          0xbc57ac4c:uint(32), 0x9b00dbd8:uint(32)));
+  assert(philox4x32_10((M, M, M, M), (M, M)) ==
+         (0x408f276d:uint(32), 0x41c83b0e:uint(32),
+          0xa20bc7c6:uint(32), 0x6d5451fd:uint(32)));
+  assert(philox4x32_10((0x243f6a88:uint(32), 0x85a308d3:uint(32),
+                        0x13198a2e:uint(32), 0x03707344:uint(32)),
+                       (0xa4093822:uint(32), 0x299f31d0:uint(32))) ==
+         (0xd16cfe09:uint(32), 0x94fdcceb:uint(32),
+          0x5001e420:uint(32), 0x24126ea1:uint(32)));
+}
+
+writeln("Checking getNext/getNth/fillRandom agree");
+{
+  var rs = makeRandomStream(seed=42, parSafe=false, eltType=uint(64),
+                            algorithm=RNG.Philox);
+  var expect: [1..n] uint(64);
+  for x in expect do x = rs.getNext();
+
+  var A: [1..n] uint(64);
+  fillRandom(A, seed=42, algorithm=RNG.Philox);
+  assert(&& reduce (A == expect));
+
+  // a 2-D fill uses the same values in row-major order
+  var B: [1..n/100, 1..100] uint(64);
+  fillRandom(B, seed=42, algorithm=RNG.Philox);
+  var i = 1;
+  for b in B {
+    assert(b == expect[i]);
+    i += 1;
+  }
+
+  assert(rs.getNth(17) == expect[17]);
+  assert(rs.getNext() == expect[18]);
+  rs.skipToNth(n);
+  assert(rs.getNext() == expect[n]);
+}
+
+writeln("Checking types");
+{
+  var R: [1..n] real;
+  fillRandom(R, seed=7, algorithm=RNG.Philox);
+  assert(&& reduce [r in R] (r >= 0.0 && r <= 1.0));
+  const avg = (+ reduce R) / n;
+  assert(abs(avg - 0.5) < 0.01);
+
+  var C: [1..10] complex;
+  fillRandom(C, seed=7, algorithm=RNG.Philox);
+  assert(C[1].re == R[1]);
+
+  var I8: [1..10] int(8);
+  fillRandom(I8, seed=7, algorithm=RNG.Philox);
+
+  var rs = makeRandomStream(seed=7, parSafe=false, eltType=int,
+                            algorithm=RNG.Philox);
+  for i in 1..1000 {
+    const x = rs.getNext(-3, 3);
+    assert(-3 <= x && x <= 3);
+  }
+}
+
+writeln("Checking shuffle and permutation");
+{
+  var P: [1..n] int;
+  permutation(P, seed=11, algorithm=RNG.Philox);
+  var seen: [1..n] int;
+  for p in P do seen[p] += 1;
+  assert(&& reduce (seen == 1));
+  assert(|| reduce (P != [i in 1..n] i));
+
+  var Q: [1..n] int;
+  permutation(Q, seed=11, algorithm=RNG.Philox);
+  assert(&& reduce (P == Q));
+
+  var S: [0..#10 by 3] int = [i in 0..#10 by 3] i;
+  shuffle(S, seed=5, algorithm=RNG.Philox);
+  writeln(+ reduce S, " ", max reduce S);
+}
@@ -0,0 +1,5 @@
+use SIMD;
+
+var v: int64x4;
+v.set(4, 1);
+writeln(v);
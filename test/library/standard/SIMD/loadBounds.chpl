@@ -0,0 +1,5 @@
+use SIMD;
+
+var A: [1..6] real;
+const v = real64x4.load(A, 4);
+writeln(v);
@@ -0,0 +1,36 @@
+use SIMD;
+
+var A: [1..10] real = [i in 1..10] i:real;
+
+const v = real64x4.load(A, 2);
+var zero: real64x4;
+writeln(v);
+writeln(zero);
+
+writeln(v + v, " ", v - 1.0, " ", 2.0 * v, " ", v / v);
+writeln(-v, " ", min(v, real64x4.splat(3.0)), " ", max(v, real64x4.splat(3.0)));
+writeln(v.sum(), " ", v.min(), " ", v.max(), " ", v(0), " ", v(3));
+
+const m = v < 3.5;
+writeln(m, " ", m.type == int64x4);
+writeln(blend(m, v, 0.0), " ", blend(v >= 4.0, -v, v));
+writeln(v == v, " ", v != v, " ", v <= 3.0, " ", v > 3.0);
+
+const idx = (9, 0, 3, 3):int64x4;
+writeln(gather(A, idx));
+
+var w = v;
+w.set(1, 42.0);
+w += 1.0;
+w.store(A, 7);
+writeln(A);
+
+var f = real32x8.splat(1.5:real(32));
+f *= f;
+writeln(f, " ", f.sum());
+
+var B: [0..#8] int(32) = [i in 0..#8] (i*i):int(32);
+const b = int32x8.load(B, 0);
+writeln(b / 2:int(32), " ", b > 10:int(32));
+var C: [0..#8] real(32) = [i in 0..#8] (i*10):real(32);
+writeln(gather(C, b / 8:int(32)));
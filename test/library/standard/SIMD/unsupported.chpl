@@ -0,0 +1,4 @@
+use SIMD;
+
+var v: simd(int(8), 16);
+writeln(v);
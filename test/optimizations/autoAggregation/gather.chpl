@@ -0,0 +1,23 @@
+use BlockDist;
+
+config const n = 1000;
+
+const D = {0..#n} dmapped Block({0..#n});
+var A, B, C: [D] int;
+var S, T: [D] string;
+
+forall i in D do A[i] = i;
+forall i in D do S[i] = i:string;
+
+// indirect reads, mostly from other locales
+forall i in D do B[i] = A[(i * 7) % n];
+
+// shifted reads, iterating over the destination's domain
+forall i in B.domain do C[i] = A[(i + n/2) % n];
+
+// not aggregated: the elements are not plain old data
+forall i in D do T[i] = S[(i + 1) % n];
+
+writeln(&& reduce [i in D] (B[i] == (i * 7) % n));
+writeln(&& reduce [i in D] (C[i] == (i + n/2) % n));
+writeln(&& reduce [i in D] (T[i] == ((i + 1) % n):string));
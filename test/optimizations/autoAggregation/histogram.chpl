@@ -0,0 +1,35 @@
+use BlockDist;
+
+config const n = 1000,
+             nBuckets = 64;
+
+const D = {0..#n} dmapped Block({0..#n}),
+      B = {0..#nBuckets} dmapped Block({0..#nBuckets});
+
+var keys: [D] int;
+var counts: [B] atomic int;
+var sums: [B] atomic real;
+var bits: [B] atomic uint;
+var flags: [B] atomic bool;
+
+forall i in D do keys[i] = (i * 37) % nBuckets;
+
+// histogram: one remote increment per key
+forall k in keys do counts[k].add(1);
+
+// the fetched value is not used, so this aggregates too
+forall (i, k) in zip(D, keys) do sums[k].fetchAdd(i:real);
+
+forall k in keys do bits[k].or(1:uint << (k % 8));
+
+// not aggregated: atomic bools have no add()-like updates
+forall k in keys do flags[k].write(true);
+
+// not aggregated: the operand reads the array being updated
+forall k in keys do counts[(k + 1) % nBuckets].sub(counts[k].read() - counts[k].read());
+
+writeln((+ reduce [c in counts] c.read()) == n);
+writeln(&& reduce [b in B] (counts[b].read() == + reduce [k in keys] (k == b)));
+writeln((+ reduce [s in sums] s.read()) == (+ reduce [i in D] i:real));
+writeln(&& reduce [b in B] (bits[b].read() == 1:uint << (b % 8)));
+writeln(&& reduce [f in flags] f.read());
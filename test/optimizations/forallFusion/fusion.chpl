@@ -0,0 +1,54 @@
+config const n = 10;
+
+const D = {1..n};
+var A, B, C, E: [D] real;
+var F: [1..n] real;
+const alpha = 2.0;
+
+forall i in D do A[i] = i;
+forall i in D do B[i] = A[i] * 2;
+
+proc promoted() {
+  var T = A + alpha*B;
+  C = T * 2;
+  E = sqrt(C);
+}
+
+// the temporary is used afterwards, so it is kept
+proc keepsTemp() {
+  var T = A + B;
+  C = T - 1;
+  E += C;
+  return + reduce T;
+}
+
+// F is declared over a different domain: not fused at run time
+proc differentDomains() {
+  C = A + 1;
+  F = C * 2;
+}
+
+// x is assigned but not an array: not fused
+proc scalarTarget(ref x: real) {
+  x = x + alpha;
+  C = A * x;
+  E = C - x;
+}
+
+// the second loop reads B at other indices than its own: not fused
+proc shifted() {
+  forall i in D do B[i] = A[i] + 1;
+  forall i in D do C[i] = B[(i % n) + 1];
+}
+
+promoted();
+writeln(E);
+writeln(keepsTemp());
+writeln(E);
+differentDomains();
+writeln(F);
+var x = 1.0;
+scalarTarget(x);
+writeln(E);
+shifted();
+writeln(C);
@@ -0,0 +1,34 @@
+// A user overload of '+' for whole arrays is not elementwise, so
+// statements applying it are not fused.  Statements that only promote
+// scalar operators still are.
+config const n = 5;
+
+const D = {1..n};
+var A, B, C, E: [D] int;
+
+proc +(X: [?Dom] int, Y: [Dom] int) {
+  var R: [Dom] int;
+  for (r, i) in zip(R, Dom) do r = X[Dom.high - i + Dom.low] + Y[i];
+  return R;
+}
+
+proc reversed() {
+  C = A + B;
+  E = C * 2;
+}
+
+proc promotedOnly() {
+  C = A - B;
+  E = C * 2;
+}
+
+forall i in D do A[i] = i;
+forall i in D do B[i] = 10 * i;
+
+reversed();
+writeln(C);
+writeln(E);
+
+promotedOnly();
+writeln(C);
+writeln(E);
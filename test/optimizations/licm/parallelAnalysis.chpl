@@ -0,0 +1,37 @@
+// Analyze functions for LICM on several compiler threads and check (with
+// --verify) that the result matches a serial analysis.
+
+config const n = 4;
+
+proc triangle(m: int) {
+  var total = 0;
+  for i in 1..m {
+    const scale = m * 2;
+    for j in 1..i {
+      total += scale + j;
+    }
+  }
+  return total;
+}
+
+proc countdown(start: int) {
+  var i = start;
+  var steps = 0;
+  while i > 0 {
+    const half = start / 2;
+    if i > half then steps += 2; else steps += 1;
+    i -= 1;
+  }
+  return steps;
+}
+
+proc main() {
+  var A: [1..n] int;
+  for i in 1..n {
+    const base = n + 1;
+    A[i] = base * i;
+  }
+  writeln(A);
+  writeln(triangle(n));
+  writeln(countdown(n));
+}
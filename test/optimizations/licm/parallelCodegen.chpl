@@ -0,0 +1,74 @@
+// Compile with several compiler threads and check that the generated code
+// is the same as with one thread.  The prediff compiles this program again
+// on one thread and compares the C of every module.
+
+use Time;
+
+config const n = 8;
+
+record Point {
+  var x, y: real;
+}
+
+class Grid {
+  var rows, cols: int;
+  var data: [1..rows, 1..cols] real;
+
+  proc smooth() {
+    for i in 2..rows-1 {
+      const up = i - 1, down = i + 1;
+      for j in 2..cols-1 {
+        const weight = 1.0 / (rows * cols);
+        data[i, j] = (data[up, j] + data[down, j] + data[i, j]) * weight;
+      }
+    }
+  }
+}
+
+proc centroid(pts: [] Point) {
+  var sum: Point;
+  for p in pts {
+    const count = pts.size: real;
+    sum.x += p.x / count;
+    sum.y += p.y / count;
+  }
+  return sum;
+}
+
+proc histogram(A: [] int, buckets: int) {
+  var counts: [0..#buckets] int;
+  for a in A {
+    const width = max(1, A.size / buckets);
+    counts[min(a / width, buckets - 1)] += 1;
+  }
+  return counts;
+}
+
+proc scaled(type t, A: [] t, factor: t) {
+  var B: [A.domain] t;
+  forall i in A.domain with (ref B) do
+    B[i] = A[i] * factor;
+  return B;
+}
+
+proc main() {
+  var pts: [1..n] Point;
+  for i in 1..n do
+    pts[i] = new Point(i, 2 * i);
+  writeln(centroid(pts));
+
+  var A: [1..n*4] int = [i in 1..n*4] i;
+  writeln(histogram(A, 4));
+  writeln(scaled(int, A[1..n], 3));
+  writeln(scaled(real, [1.5, 2.5], 2.0));
+
+  var g = new owned Grid(n, n);
+  g.data = 1.0;
+  g.smooth();
+  writeln(+ reduce g.data);
+
+  var t: Timer;
+  t.start();
+  t.stop();
+  writeln(t.elapsed() >= 0.0);
+}
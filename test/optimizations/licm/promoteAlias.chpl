@@ -0,0 +1,32 @@
+// A field updated in a loop must not be kept in a local when the loop also
+// writes it through a reference whose binding is not visible in the
+// function.
+class C {
+  var total: int;
+}
+
+proc viaRefFormal(c: unmanaged C, ref x: int, n: int) {
+  for i in 1..n {
+    c.total += i;
+    x += 100;
+  }
+}
+
+var c = new unmanaged C();
+ref g = c.total;
+
+proc viaRefGlobal(c: unmanaged C, n: int) {
+  for i in 1..n {
+    c.total += i;
+    g += 100;
+  }
+}
+
+viaRefFormal(c, c.total, 3);
+writeln(c.total);
+
+c.total = 0;
+viaRefGlobal(c, 3);
+writeln(c.total);
+
+delete c;
@@ -0,0 +1,82 @@
+// Loads of remote class fields that do not change in a loop are hoisted out
+// of it, and fields that a loop updates are kept in a local until it exits.
+use CommDiagnostics;
+
+class C {
+  var x: int;
+  var total: int;
+  var sum: real;
+}
+
+config const n = 1000;
+
+proc readConstRef(const ref c: unmanaged C) {
+  var sum = 0;
+  for i in 1..n do sum += c.x * i;
+  return sum;
+}
+
+proc accumulate(c: unmanaged C) {
+  for i in 1..n {
+    c.total += i;
+    c.sum += i * 0.5;
+  }
+}
+
+proc accumulateTo(c: unmanaged C, m: int) {
+  for i in 1..m do c.total += i;
+}
+
+// The field is read outside of the references to it, so it stays in memory
+proc accumulateUntil(c: unmanaged C, limit: int) {
+  for i in 1..n {
+    if c.total > limit then break;
+    c.total += i;
+  }
+}
+
+// 'c' and 'd' may be the same object, so neither field is promoted
+proc accumulateBoth(c: unmanaged C, d: unmanaged C) {
+  for i in 1..n {
+    c.total += i;
+    d.total += i;
+  }
+}
+
+proc report(what: string, c: unmanaged C) {
+  stopCommDiagnostics();
+  const stats = getCommDiagnostics();
+  writeln(what, ": total = ", c.total, ", sum = ", c.sum,
+          ", gets = ", stats(0).get, ", puts = ", stats(0).put);
+  resetCommDiagnostics();
+  c.total = 0;
+  c.sum = 0.0;
+}
+
+var c: unmanaged C;
+on Locales[numLocales-1] do c = new unmanaged C(3);
+
+startCommDiagnostics();
+const sum = readConstRef(c);
+stopCommDiagnostics();
+writeln("readConstRef: ", sum, ", gets = ", getCommDiagnostics()(0).get);
+resetCommDiagnostics();
+
+startCommDiagnostics();
+accumulate(c);
+report("accumulate", c);
+
+startCommDiagnostics();
+accumulateTo(c, 0);
+accumulateTo(nil, 0);
+report("accumulateTo 0", c);
+
+startCommDiagnostics();
+accumulateUntil(c, 100);
+report("accumulateUntil", c);
+
+startCommDiagnostics();
+accumulateBoth(c, c);
+report("accumulateBoth", c);
+
+delete c;
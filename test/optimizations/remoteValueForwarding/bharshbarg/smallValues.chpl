@@ -0,0 +1,50 @@
+// Const records and tuples that are modified outside of an on-statement,
+// but only read within it, are forwarded by value.
+
+record Params {
+  var lo, hi: int;
+  var scale: real;
+}
+
+proc main() {
+  var p = new Params(1, 10, 2.0);
+  var t = (1.5, 2.5, 3.5);
+  var big: 40*int;
+  var sum = 0.0;
+
+  p.hi += 1;
+  t(1) = 0.5;
+
+  // 'p' and 't' are forwarded, 'big' is too large
+  on Locales[numLocales-1] {
+    var s = 0.0;
+    for i in p.lo..p.hi do
+      s += i * p.scale + t(1) + t(3) + big(7);
+    sum = s;
+  }
+  writeln(sum);
+
+  // modified in the on-statement: not forwarded
+  on Locales[numLocales-1] {
+    p.lo = 5;
+  }
+  writeln(p);
+
+  // modified through an alias: not forwarded
+  ref rp = p;
+  on Locales[numLocales-1] {
+    rp.hi = p.lo + 1;
+    writeln(p);
+  }
+
+  // the on-statement synchronizes with another task: not forwarded
+  var flag: atomic bool;
+  begin with (ref t) {
+    t(2) = 7.0;
+    flag.write(true);
+  }
+  on Locales[numLocales-1] {
+    flag.waitFor(true);
+    writeln(t(2));
+  }
+}
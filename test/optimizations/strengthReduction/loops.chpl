@@ -0,0 +1,43 @@
+config const n = 10;
+
+var A, B, C: [1..n, 1..n] real;
+
+for i in 1..n do
+  for j in 1..n {
+    A[i,j] = i + j / 8.0;
+    B[i,j] = i * 0.5 - j;
+  }
+
+// the innermost accesses to B and C walk along a row
+for i in 1..n do
+  for k in 1..n do
+    for j in 1..n do
+      C[i,j] += A[i,k] * B[k,j];
+
+writeln(+ reduce C);
+
+// strided arrays
+var S: [1..20 by 3, 0..9 by 2] int;
+for i in 1..20 by 3 do
+  for j in 0..9 by 2 do
+    S[i,j] = i * 100 + j;
+writeln(S);
+
+// walking along a middle dimension
+var T: [1..4, 1..5, 1..6] int;
+for i in 1..4 do
+  for k in 1..6 do
+    for j in 1..5 do
+      T[i,j,k] = i * 100 + j * 10 + k;
+writeln(+ reduce T, " ", T[2,3,4]);
+
+// not reduced: the loop body calls a non-inline function
+for i in 1..n do
+  for j in 1..n do
+    if A[i,j] == 2.0 then writeln(A[i,j]);
+
+// not reduced: the row is a variable that the loop could change
+var row = 3;
+for j in 1..n do
+  A[row, j] = 0.0;
+writeln(+ reduce A);
@@ -0,0 +1,24 @@
+config const n = 4;
+
+var A: [1..n, 1..n] int;
+
+// not reduced: the accesses are in on and task blocks, where a base
+// hoisted out of the loop could belong to another locale
+for i in 1..n do
+  for j in 1..n do
+    on Locales[numLocales-1] do
+      A[i,j] = i * 10 + j;
+writeln(+ reduce A);
+
+sync for i in 1..n do
+  for j in 1..n do
+    begin with (ref A) A[i,j] += 1;
+writeln(+ reduce A);
+
+for i in 1..n do
+  for j in 1..n do
+    cobegin with (ref A) {
+      A[i,j] += 1;
+      A[i,j] += 1;
+    }
+writeln(+ reduce A);
@@ -0,0 +1,19 @@
+// Once a local block has checked that a reference is local, the later
+// checks of it and the accesses through it after the block are narrowed.
+
+class C {
+  var x, y: int;
+}
+
+proc update(c: unmanaged C) {
+  local {
+    c.x = 1;
+    c.y = 2;
+  }
+  c.x += c.y;
+  return c.x;
+}
+
+var c = new unmanaged C();
+writeln(update(c));
+delete c;
@@ -0,0 +1,50 @@
+// Loops accessing data through loop-invariant wide pointers are versioned
+// on the locality of those pointers.
+
+class C {
+  var n: int;
+  var data: [1..n] real;
+}
+
+class Node {
+  var val: int;
+  var next: unmanaged Node;
+}
+
+proc main() {
+  const c = new unmanaged C(10);
+  var head: unmanaged Node;
+  for i in 1..5 do head = new unmanaged Node(i, head);
+
+  on Locales[numLocales-1] {
+    for i in 1..c.n do
+      c.data[i] = i;
+
+    var sum = 0.0;
+    for x in c.data do
+      sum += x;
+    writeln(sum);
+
+    // 'n' changes in the loop: not versioned
+    var n = head, total = 0;
+    while n != nil {
+      total += n.val;
+      n = n.next;
+    }
+    writeln(total);
+  }
+
+  // The checks after the first one are redundant
+  local {
+    c.data[1] += 1;
+    c.data[2] += c.data[1];
+  }
+  writeln(c.data[1], " ", c.data[2]);
+
+  while head != nil {
+    const next = head.next;
+    delete head;
+    head = next;
+  }
+  delete c;
+}
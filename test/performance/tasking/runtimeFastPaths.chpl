@@ -0,0 +1,51 @@
+// Fine-grained kernels that go through tasking-layer fast paths once per
+// iteration: the serial-state check at the start of every forall reads the
+// task's private data, and every locking channel operation gets the task ID.
+
+use Time;
+
+config const n = 100000;
+config const printTiming = false;
+
+var t: Timer;
+
+// Each forall checks the running task's serial state.
+{
+  var A: [1..4] int;
+  t.start();
+  serial {
+    for 1..n do
+      forall i in 1..4 do
+        A[i] += 1;
+  }
+  t.stop();
+  writeln("serial forall: ", + reduce A == 4 * n);
+  if printTiming then writeln("serial forall time: ", t.elapsed());
+  t.clear();
+}
+
+// Each write locks the channel, which needs the running task's ID.
+{
+  var f = openmem();
+  var w = f.writer(locking=true);
+  t.start();
+  for i in 1..n do
+    w.write(i % 10);
+  t.stop();
+  writeln("channel writes: ", w.offset() == n);
+  if printTiming then writeln("channel writes time: ", t.elapsed());
+  w.close();
+  f.close();
+  t.clear();
+}
+
+// Atomics were already inlined; a reference point for the kernels above.
+{
+  var x: atomic int;
+  t.start();
+  for 1..n do
+    x.add(1);
+  t.stop();
+  writeln("atomic adds: ", x.read() == n);
+  if printTiming then writeln("atomic adds time: ", t.elapsed());
+}
@@ -0,0 +1,27 @@
+// Kernels whose forall loops must be vectorizable with --vectorize
+config const n = 37, m = 53;
+
+var X, Y, Z: [1..n*m] real;
+var A, B: [1..n, 0..m-1] int;
+var C, D: [1..3, 1..4, 1..5] int;
+const alpha = 3.0;
+
+Y = 1.0;
+Z = 2.0;
+
+// 1-D stream triad
+forall (x, y, z) in zip(X, Y, Z) do x = y + alpha * z;
+writeln(+ reduce X);
+
+// zippered multidimensional arrays are followed with a single loop
+forall (i, j) in A.domain do B[i, j] = i * 1000 + j;
+forall (a, b) in zip(A, B) do a = b + 1;
+writeln(&& reduce [(i, j) in A.domain] (A[i, j] == i * 1000 + j + 1));
+
+forall (i, j, k) in C.domain do D[i, j, k] = i * 100 + j * 10 + k;
+forall (c, d) in zip(C, D) do c = d;
+writeln(&& reduce (C == D));
+
+// indexing by the loop index
+forall i in 1..n*m do X[i] = Y[i] * Z[i];
+writeln(+ reduce X);
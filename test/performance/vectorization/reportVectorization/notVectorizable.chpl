@@ -0,0 +1,23 @@
+// Loops that cannot be vectorized, and why
+config const n = 100;
+
+var A, B: [1..n by 2, 1..n] real;
+var X, Y: [1..n] real;
+
+proc f(x: real) {
+  if x > 1e9 then writeln(x);
+  return x;
+}
+
+// strided multidimensional arrays are followed with nested loops
+forall (a, b) in zip(A, B) do a = b;
+
+forall (x, y) in zip(X, Y) do x = f(y);
+
+for i in 2..n do X[i] += X[i-1];
+
+writeln(+ reduce X);
+
+// a user loop that creates tasks still says so
+sync for i in 1..n do begin with (ref Y) Y[i] = i;
+writeln(+ reduce Y);
@@ -0,0 +1,41 @@
+use Regexp;
+
+writeln("Set search");
+{
+  var s = compileSet(["[a-z]+", "[0-9]+", "x", "^ "]);
+  writeln(s.size);
+  writeln(s.search(" test 42 "));
+  writeln(s.search("xyz"));
+  writeln(s.search("?"));
+}
+
+writeln("Set search with offset indices");
+{
+  var pats: [1..3] string = ["dog", "cat", "DOG"];
+  var s = compileSet(pats, ignorecase=true);
+  var t = s;
+  writeln(t.search("hotdog"));
+  for i in s.search("cat and dog") do writeln(pats[i]);
+}
+
+writeln("Set errors");
+{
+  try {
+    var s = compileSet(["ok", "(bad"]);
+  } catch e: BadRegexpError {
+    writeln(e.message());
+  } catch e {
+    writeln("unexpected error");
+  }
+}
+
+writeln("Recompile");
+{
+  // Compiling the same pattern repeatedly hits the regexp cache.
+  var n = 0;
+  for i in 1..1000 {
+    var r = compile("a+b");
+    if r.search("xaab").matched then n += 1;
+  }
+  writeln(n);
+}
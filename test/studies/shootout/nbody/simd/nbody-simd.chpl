@@ -0,0 +1,127 @@
+/* The Computer Language Benchmarks Game
+   http://benchmarksgame.alioth.debian.org/
+
+   contributed by Albert Sidelnik
+   modified by Brad Chamberlain
+   ported to the SIMD module: positions and velocities are real64x4
+   vectors whose last lane is always 0
+*/
+
+use SIMD;
+
+const pi = 3.141592653589793,
+      solarMass = 4 * pi**2,
+      daysPerYear = 365.24;
+
+record body {
+  var pos: real64x4;
+  var v: real64x4;
+  var mass: real;
+
+  proc offsetMomentum(p) {
+    v = -p / solarMass;
+  }
+}
+
+proc vec(x: 3*real) {
+  return (x(1), x(2), x(3), 0.0):real64x4;
+}
+
+const jupiter = new body(pos = vec((4.84143144246472090e+00,
+                                    -1.16032004402742839e+00,
+                                    -1.03622044471123109e-01)),
+                         v = vec((1.66007664274403694e-03,
+                                  7.69901118419740425e-03,
+                                  -6.90460016972063023e-05)) * daysPerYear,
+                         mass = 9.54791938424326609e-04 * solarMass),
+
+      saturn = new body(pos = vec((8.34336671824457987e+00,
+                                   4.12479856412430479e+00,
+                                   -4.03523417114321381e-01)),
+                        v = vec((-2.76742510726862411e-03,
+                                 4.99852801234917238e-03,
+                                 2.30417297573763929e-05)) * daysPerYear,
+                        mass = 2.85885980666130812e-04 * solarMass),
+
+      uranus = new body(pos = vec((1.28943695621391310e+01,
+                                   -1.51111514016986312e+01,
+                                   -2.23307578892655734e-01)),
+                        v = vec((2.96460137564761618e-03,
+                                 2.37847173959480950e-03,
+                                 -2.96589568540237556e-05)) * daysPerYear,
+                        mass = 4.36624404335156298e-05 * solarMass),
+
+      neptune = new body(pos = vec((1.53796971148509165e+01,
+                                    -2.59193146099879641e+01,
+                                    1.79258772950371181e-01)),
+                         v = vec((2.68067772490389322e-03,
+                                  1.62824170038242295e-03,
+                                  -9.51592254519715870e-05)) * daysPerYear,
+                         mass = 5.15138902046611451e-05 * solarMass),
+
+      sun = new body(mass = solarMass);
+
+inline proc sumOfSquares(x: real64x4) {
+  return (x * x).sum();
+}
+
+record NBodySystem {
+  var bodies = [sun, jupiter, saturn, uranus, neptune];
+  const numbodies = bodies.numElements;
+
+  proc postinit() {
+    var p: real64x4;
+    for b in bodies do
+      p += b.v * b.mass;
+    bodies[1].offsetMomentum(p);
+  }
+
+  proc advance(dt) {
+    for i in 1..numbodies {
+      for j in i+1..numbodies {
+        updateVelocities(bodies[i], bodies[j]);
+
+        inline proc updateVelocities(ref b1, ref b2) {
+          const dpos = b1.pos - b2.pos,
+                dist2 = sumOfSquares(dpos),
+                mag = dt / (dist2 * sqrt(dist2));
+
+          b1.v -= dpos * (b2.mass * mag);
+          b2.v += dpos * (b1.mass * mag);
+        }
+      }
+    }
+
+    for b in bodies do
+      b.pos += b.v * dt;
+  }
+
+  proc energy() {
+    var e = 0.0;
+
+    for i in 1..numbodies {
+      const b1 = bodies[i];
+
+      e += 0.5 * b1.mass * sumOfSquares(b1.v);
+
+      for j in i+1..numbodies {
+        const b2 = bodies[j];
+
+        e -= (b1.mass * b2.mass) / sqrt(sumOfSquares(b1.pos - b2.pos));
+      }
+    }
+
+    return e;
+  }
+}
+
+proc main(args: [] string) {
+  const n = args[1]:int;
+
+  var bodies: NBodySystem;
+
+  writef("%.9r\n", bodies.energy());
+  for 1..n do
+    bodies.advance(0.01);
+  writef("%.9r\n", bodies.energy());
+}